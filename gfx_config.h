@@ -0,0 +1,71 @@
+/**
+ * @file gfx_config.h
+ * @brief Build-time configuration for the GFX layer
+ *
+ * Selects how gfx_pic.c reaches the display driver. By default every
+ * primitive goes through the function pointers registered in GFX_t, so any
+ * number of display drivers can share one GFX build.
+ *
+ * @author @btondin
+ * @date 2025
+ */
+
+#ifndef GFX_CONFIG_H
+#define GFX_CONFIG_H
+
+//==============================================================================
+// DRIVER BINDING
+//==============================================================================
+
+/**
+ * @brief Bind the GFX layer statically to the SSD1331 driver
+ *
+ * When defined, gfx_pic.c calls the SSD1331 primitives directly instead of
+ * through the GFX_t hooks. This removes the indirect call (and its stack
+ * frame) from every pixel, span and text run, and lets the compiler check
+ * the argument types. Only valid when the SSD1331 is the sole display in
+ * the build; the hooks are still registered but no longer consulted.
+ */
+// #define GFX_DRIVER_SSD1331
+
+/*
+ * A static binding names the driver header and, for every GFX_t hook, the
+ * function that implements it (GFX_DRIVER_<hook>) and whether the driver
+ * provides it at all (GFX_DRIVER_HAS_<hook>). gfx_pic.c includes the header
+ * through GFX_DRIVER_HEADER, so binding another driver only takes a new
+ * block here.
+ */
+#ifdef GFX_DRIVER_SSD1331
+
+#define GFX_DRIVER_HEADER           "ssd1331.h"
+
+#define GFX_DRIVER_drawPixel        SSD1331_DrawPixel
+#define GFX_DRIVER_fillScreen       SSD1331_FillScreen
+#define GFX_DRIVER_drawFastVLine    SSD1331_DrawFastVLine
+#define GFX_DRIVER_drawFastHLine    SSD1331_DrawFastHLine
+#define GFX_DRIVER_fillRect         SSD1331_FillRect
+#define GFX_DRIVER_drawLine         SSD1331_DrawLine
+#define GFX_DRIVER_drawRect         SSD1331_DrawRect
+#define GFX_DRIVER_copyArea         SSD1331_CopyRect
+#define GFX_DRIVER_writePixel       SSD1331_WriteData16
+#define GFX_DRIVER_setAddrWindow    SSD1331_SetAddrWindow
+#define GFX_DRIVER_writeColor       SSD1331_WriteColor
+#define GFX_DRIVER_writePixels      SSD1331_WritePixels
+
+// Mirrors what SSD1331_Init registers: fillScreen is left to the GFX fallback
+#define GFX_DRIVER_HAS_drawPixel        true
+#define GFX_DRIVER_HAS_fillScreen       false
+#define GFX_DRIVER_HAS_drawFastVLine    true
+#define GFX_DRIVER_HAS_drawFastHLine    true
+#define GFX_DRIVER_HAS_fillRect         true
+#define GFX_DRIVER_HAS_drawLine         true
+#define GFX_DRIVER_HAS_drawRect         true
+#define GFX_DRIVER_HAS_copyArea         true
+#define GFX_DRIVER_HAS_writePixel       true
+#define GFX_DRIVER_HAS_setAddrWindow    true
+#define GFX_DRIVER_HAS_writeColor       true
+#define GFX_DRIVER_HAS_writePixels      true
+
+#endif
+
+#endif /* GFX_CONFIG_H */
@@ -23,6 +23,61 @@
 #define min(a, b) (((a) < (b)) ? (a) : (b))
 #endif
 
+#ifndef max
+#define max(a, b) (((a) > (b)) ? (a) : (b))
+#endif
+
+/** @brief Cohen-Sutherland outcode bits */
+#define GFX_OUT_LEFT    0x01
+#define GFX_OUT_RIGHT   0x02
+#define GFX_OUT_TOP     0x04
+#define GFX_OUT_BOTTOM  0x08
+
+/** @brief Fixed-point 1.0 of arc ray directions */
+#define GFX_ARC_ONE     16384
+
+/** @brief Shades between background and line color in GFX_DrawLineAA */
+#define GFX_AA_SHIFT    4
+#define GFX_AA_LEVELS   (1 << GFX_AA_SHIFT)
+
+/** @brief A GFX_Bayer entry in 1/256 of a level, centred in its step */
+#define GFX_BAYER_THRESHOLD(t)  ((uint8_t)(((t) << 4) + 8))
+
+//==============================================================================
+// DRIVER DISPATCH
+//==============================================================================
+
+/*
+ * GFX_HAS(gfx, hook) tells whether the driver provides a primitive and
+ * GFX_CALL(gfx, hook) names the function to call for it. In the default
+ * build both go through the GFX_t hooks; when gfx_config.h binds a driver
+ * statically they resolve at compile time to the functions it names, so
+ * the tests fold away and every call is direct.
+ */
+#ifdef GFX_DRIVER_HEADER
+
+#include GFX_DRIVER_HEADER
+
+#define GFX_HAS(gfx, hook)      GFX_DRIVER_HAS_##hook
+#define GFX_CALL(gfx, hook)     GFX_DRIVER_##hook
+
+#else
+
+#define GFX_HAS(gfx, hook)      ((gfx)->hook != NULL)
+#define GFX_CALL(gfx, hook)     (gfx)->hook
+
+#endif
+
+//==============================================================================
+// SHARED BUFFERS
+//==============================================================================
+
+/** @brief Pixels built up before a single writePixels call */
+static uint16_t row_buffer[GFX_LINE_PIXELS];
+
+/** @brief Per-row counts, then bucket offsets, for the pixel batch sorts */
+static uint8_t pixel_rows[GFX_SORT_ROWS + 1];
+
 //==============================================================================
 // DEFAULT FONT DATA (5x7 BITMAP FONT)
 //==============================================================================
@@ -147,6 +202,26 @@ void GFX_Swap(int16_t *a, int16_t *b) {
     *b = t;
 }
 
+/**
+ * @brief Blend two RGB565 colors
+ * 
+ * Spreads each color to 0x07E0F81F (green moved to the top half) so all
+ * three channels have 5 spare bits above them, then weights both with
+ * one multiply each and packs the result back.
+ * 
+ * @param fg Foreground color
+ * @param bg Background color
+ * @param alpha Weight of fg, 0 (all bg) to 32 (all fg)
+ * @return Blended color
+ */
+uint16_t GFX_Blend565(uint16_t fg, uint16_t bg, uint8_t alpha) {
+    uint32_t f = (fg | ((uint32_t)fg << 16)) & 0x07E0F81FUL;
+    uint32_t b = (bg | ((uint32_t)bg << 16)) & 0x07E0F81FUL;
+    uint32_t c = ((f * alpha + b * (32 - alpha)) >> 5) & 0x07E0F81FUL;
+    
+    return (uint16_t)(c | (c >> 16));
+}
+
 //==============================================================================
 // INITIALIZATION FUNCTIONS
 //==============================================================================
@@ -188,7 +263,226 @@ void GFX_Init(GFX_t *gfx, int16_t w, int16_t h) {
     gfx->drawFastVLine = NULL;
     gfx->drawFastHLine = NULL;
     gfx->fillRect = NULL;
+    gfx->drawLine = NULL;
+    gfx->drawRect = NULL;
+    gfx->copyArea = NULL;
     gfx->writePixel = NULL;
+    gfx->setAddrWindow = NULL;
+    gfx->writeColor = NULL;
+    gfx->writePixels = NULL;
+    
+    // Clip to the whole display
+    GFX_ResetClip(gfx);
+}
+
+//==============================================================================
+// CLIPPING FUNCTIONS
+//==============================================================================
+
+/**
+ * @brief Reset clipping to the whole display and empty the clip stack
+ * 
+ * Drivers call this whenever width or height change (e.g. on rotation).
+ * 
+ * @param gfx Pointer to graphics context
+ */
+void GFX_ResetClip(GFX_t *gfx) {
+    gfx->clip.x0 = 0;
+    gfx->clip.y0 = 0;
+    gfx->clip.x1 = gfx->width - 1;
+    gfx->clip.y1 = gfx->height - 1;
+    gfx->clip_depth = 0;
+}
+
+/**
+ * @brief Set the clip rectangle (intersected with the display)
+ * 
+ * An empty rectangle is allowed and hides all drawing.
+ * 
+ * @param gfx Pointer to graphics context
+ * @param x Left edge
+ * @param y Top edge
+ * @param w Width in pixels
+ * @param h Height in pixels
+ */
+void GFX_SetClipRect(GFX_t *gfx, int16_t x, int16_t y, int16_t w, int16_t h) {
+    gfx->clip.x0 = (x > 0) ? x : 0;
+    gfx->clip.y0 = (y > 0) ? y : 0;
+    gfx->clip.x1 = min(x + w - 1, gfx->width - 1);
+    gfx->clip.y1 = min(y + h - 1, gfx->height - 1);
+}
+
+/**
+ * @brief Save the clip rectangle and narrow it to its intersection with a new one
+ * 
+ * Lets nested widgets restrict drawing to their panel without knowing
+ * the clipping set up by their parents.
+ * 
+ * @param gfx Pointer to graphics context
+ * @param x Left edge
+ * @param y Top edge
+ * @param w Width in pixels
+ * @param h Height in pixels
+ * @return false if the clip stack is full (clipping is left unchanged)
+ */
+bool GFX_PushClip(GFX_t *gfx, int16_t x, int16_t y, int16_t w, int16_t h) {
+    if (gfx->clip_depth >= GFX_CLIP_DEPTH) {
+        return false;
+    }
+    gfx->clip_stack[gfx->clip_depth++] = gfx->clip;
+    
+    if (x > gfx->clip.x0) gfx->clip.x0 = x;
+    if (y > gfx->clip.y0) gfx->clip.y0 = y;
+    if (x + w - 1 < gfx->clip.x1) gfx->clip.x1 = x + w - 1;
+    if (y + h - 1 < gfx->clip.y1) gfx->clip.y1 = y + h - 1;
+    return true;
+}
+
+/**
+ * @brief Restore the clip rectangle saved by the matching GFX_PushClip
+ * @param gfx Pointer to graphics context
+ */
+void GFX_PopClip(GFX_t *gfx) {
+    if (gfx->clip_depth > 0) {
+        gfx->clip = gfx->clip_stack[--gfx->clip_depth];
+    }
+}
+
+/**
+ * @brief Trim a rectangle to the clip rectangle
+ * @param gfx Pointer to graphics context
+ * @param x Left edge, updated
+ * @param y Top edge, updated
+ * @param w Width, updated
+ * @param h Height, updated
+ * @return false if nothing of the rectangle is visible
+ */
+bool GFX_ClipRect(GFX_t *gfx, int16_t *x, int16_t *y, int16_t *w, int16_t *h) {
+    if (*x < gfx->clip.x0) {
+        *w -= gfx->clip.x0 - *x;
+        *x = gfx->clip.x0;
+    }
+    if (*y < gfx->clip.y0) {
+        *h -= gfx->clip.y0 - *y;
+        *y = gfx->clip.y0;
+    }
+    if (*x + *w - 1 > gfx->clip.x1) {
+        *w = gfx->clip.x1 - *x + 1;
+    }
+    if (*y + *h - 1 > gfx->clip.y1) {
+        *h = gfx->clip.y1 - *y + 1;
+    }
+    return (*w > 0) && (*h > 0);
+}
+
+/**
+ * @brief Test whether a bounding box touches the clip rectangle
+ * 
+ * Shapes use this to skip their rasteriser when they are entirely hidden.
+ * 
+ * @param gfx Pointer to graphics context
+ * @param x0 Left edge
+ * @param y0 Top edge
+ * @param x1 Right edge (inclusive)
+ * @param y1 Bottom edge (inclusive)
+ * @return true if any part of the box may be visible
+ */
+bool GFX_BoxVisible(GFX_t *gfx, int16_t x0, int16_t y0, int16_t x1, int16_t y1) {
+    return (x1 >= gfx->clip.x0) && (x0 <= gfx->clip.x1) &&
+           (y1 >= gfx->clip.y0) && (y0 <= gfx->clip.y1);
+}
+
+/**
+ * @brief Compute the Cohen-Sutherland outcode of a point
+ * @param clip Clip rectangle
+ * @param x X coordinate
+ * @param y Y coordinate
+ * @return Combination of GFX_OUT_* bits
+ */
+static uint8_t GFX_OutCode(const GFX_Rect_t *clip, int16_t x, int16_t y) {
+    uint8_t code = 0;
+    
+    if (x < clip->x0) code |= GFX_OUT_LEFT;
+    else if (x > clip->x1) code |= GFX_OUT_RIGHT;
+    if (y < clip->y0) code |= GFX_OUT_TOP;
+    else if (y > clip->y1) code |= GFX_OUT_BOTTOM;
+    return code;
+}
+
+/**
+ * @brief Compute a * b / d rounded to the nearest integer
+ * @param a First factor
+ * @param b Second factor
+ * @param d Divisor (non-zero)
+ * @return Rounded quotient
+ */
+static int16_t GFX_MulDivRound(int32_t a, int32_t b, int32_t d) {
+    int32_t n = a * b;
+    
+    if (d < 0) {
+        n = -n;
+        d = -d;
+    }
+    return (int16_t)((n >= 0) ? (n + d / 2) / d : -((-n + d / 2) / d));
+}
+
+/**
+ * @brief Clip a line segment to the clip rectangle (Cohen-Sutherland)
+ * 
+ * Each pass moves one outside endpoint onto the edge it crosses, so a
+ * segment needs at most four passes; anything still outside after that
+ * only grazes a corner and is rejected.
+ * 
+ * @param gfx Pointer to graphics context
+ * @param x0 Start X coordinate, updated
+ * @param y0 Start Y coordinate, updated
+ * @param x1 End X coordinate, updated
+ * @param y1 End Y coordinate, updated
+ * @return false if nothing of the line is visible
+ */
+bool GFX_ClipLine(GFX_t *gfx, int16_t *x0, int16_t *y0, int16_t *x1, int16_t *y1) {
+    const GFX_Rect_t *clip = &gfx->clip;
+    uint8_t code0 = GFX_OutCode(clip, *x0, *y0);
+    uint8_t code1 = GFX_OutCode(clip, *x1, *y1);
+    
+    for (uint8_t pass = 0; pass < 4; pass++) {
+        if (!(code0 | code1)) {
+            return true;            // Both endpoints inside
+        }
+        if (code0 & code1) {
+            return false;           // Both beyond the same edge
+        }
+        
+        uint8_t code = code0 ? code0 : code1;
+        int16_t dx = *x1 - *x0;
+        int16_t dy = *y1 - *y0;
+        int16_t x, y;
+        
+        if (code & GFX_OUT_TOP) {
+            y = clip->y0;
+            x = *x0 + GFX_MulDivRound(dx, y - *y0, dy);
+        } else if (code & GFX_OUT_BOTTOM) {
+            y = clip->y1;
+            x = *x0 + GFX_MulDivRound(dx, y - *y0, dy);
+        } else if (code & GFX_OUT_LEFT) {
+            x = clip->x0;
+            y = *y0 + GFX_MulDivRound(dy, x - *x0, dx);
+        } else {
+            x = clip->x1;
+            y = *y0 + GFX_MulDivRound(dy, x - *x0, dx);
+        }
+        
+        if (code == code0) {
+            *x0 = x;
+            *y0 = y;
+            code0 = GFX_OutCode(clip, x, y);
+        } else {
+            *x1 = x;
+            *y1 = y;
+            code1 = GFX_OutCode(clip, x, y);
+        }
+    }
+    return !(code0 | code1);
 }
 
 //==============================================================================
@@ -198,7 +492,8 @@ void GFX_Init(GFX_t *gfx, int16_t w, int16_t h) {
 /**
  * @brief Draw a pixel at specified coordinates
  * 
- * Calls the hardware-specific drawPixel function if available.
+ * Pixels outside the clip rectangle are dropped; otherwise calls the
+ * hardware-specific drawPixel function if available.
  * 
  * @param gfx Pointer to graphics context
  * @param display Pointer to display driver instance
@@ -207,8 +502,11 @@ void GFX_Init(GFX_t *gfx, int16_t w, int16_t h) {
  * @param color Pixel color
  */
 void GFX_DrawPixel(GFX_t *gfx, void *display, int16_t x, int16_t y, uint16_t color) {
-    if (gfx->drawPixel) {
-        gfx->drawPixel(display, x, y, color);
+    if ((x < gfx->clip.x0) || (x > gfx->clip.x1) || (y < gfx->clip.y0) || (y > gfx->clip.y1)) {
+        return;
+    }
+    if (GFX_HAS(gfx, drawPixel)) {
+        GFX_CALL(gfx, drawPixel)(display, x, y, color);
     }
 }
 
@@ -222,8 +520,233 @@ void GFX_DrawPixel(GFX_t *gfx, void *display, int16_t x, int16_t y, uint16_t col
  * @param color Pixel color to write
  */
 void GFX_WritePixel(GFX_t *gfx, void *display, uint16_t color) {
-    if (gfx->writePixel) {
-        gfx->writePixel(display, color);
+    if (GFX_HAS(gfx, writePixel)) {
+        GFX_CALL(gfx, writePixel)(display, color);
+    }
+}
+
+//==============================================================================
+// PIXEL BATCH FUNCTIONS
+//==============================================================================
+
+/**
+ * @brief Bucket of a point for the pixel batch sorts
+ * @param gfx Pointer to graphics context
+ * @param p Point to classify
+ * @return Row offset inside the clip rectangle, or GFX_SORT_ROWS if the
+ *         point is hidden or lies beyond the last bucket
+ */
+static uint8_t GFX_PixelBucket(GFX_t *gfx, const GFX_Point_t *p) {
+    if ((p->x < gfx->clip.x0) || (p->x > gfx->clip.x1) ||
+        (p->y < gfx->clip.y0) || (p->y > gfx->clip.y1) ||
+        (p->y - gfx->clip.y0 >= GFX_SORT_ROWS)) {
+        return GFX_SORT_ROWS;
+    }
+    return (uint8_t)(p->y - gfx->clip.y0);
+}
+
+/**
+ * @brief Compare two points in raster order
+ * @return true if a comes after b (lower row, or same row further right)
+ */
+static bool GFX_PixelAfter(const GFX_Point_t *a, const GFX_Point_t *b) {
+    return (a->y > b->y) || ((a->y == b->y) && (a->x > b->x));
+}
+
+/**
+ * @brief Send the pixels collected in the row buffer
+ * @param gfx Pointer to graphics context
+ * @param display Pointer to display driver instance
+ * @param x X coordinate of the first pixel
+ * @param y Row of the run
+ * @param len Number of pixels in the run
+ */
+static void GFX_PixelRunFlush(GFX_t *gfx, void *display, int16_t x, int16_t y, uint8_t len) {
+    if ((len > 1) && GFX_HAS(gfx, setAddrWindow) && GFX_HAS(gfx, writePixels)) {
+        GFX_CALL(gfx, setAddrWindow)(display, x, y, len, 1);
+        GFX_CALL(gfx, writePixels)(display, row_buffer, len);
+        return;
+    }
+    if (!GFX_HAS(gfx, drawPixel)) {
+        return;
+    }
+    for (uint8_t i = 0; i < len; i++) {
+        GFX_CALL(gfx, drawPixel)(display, x + i, y, row_buffer[i]);
+    }
+}
+
+/**
+ * @brief Draw sorted, visible pixels as horizontal runs
+ * 
+ * Consecutive pixels on the same row are collected in the row buffer
+ * until a gap, a new row or a full buffer; a repeated point overwrites
+ * the previous color.
+ * 
+ * @param gfx Pointer to graphics context
+ * @param display Pointer to display driver instance
+ * @param pts Pixel coordinates
+ * @param colors Pixel colors
+ * @param order Indices in raster order, or NULL if pts is already sorted
+ * @param n Number of pixels
+ */
+static void GFX_PixelRuns(GFX_t *gfx, void *display, const GFX_Point_t *pts, const uint16_t *colors,
+                          const uint8_t *order, uint8_t n) {
+    int16_t x = 0, y = 0;
+    uint8_t len = 0;
+    
+    for (uint8_t i = 0; i < n; i++) {
+        uint8_t k = order ? order[i] : i;
+        const GFX_Point_t *p = &pts[k];
+        
+        if (len && (p->y == y)) {
+            if (p->x == x + len - 1) {
+                row_buffer[len - 1] = colors[k];
+                continue;
+            }
+            if ((p->x == x + len) && (len < GFX_LINE_PIXELS)) {
+                row_buffer[len++] = colors[k];
+                continue;
+            }
+        }
+        if (len) {
+            GFX_PixelRunFlush(gfx, display, x, y, len);
+        }
+        x = p->x;
+        y = p->y;
+        row_buffer[0] = colors[k];
+        len = 1;
+    }
+    if (len) {
+        GFX_PixelRunFlush(gfx, display, x, y, len);
+    }
+}
+
+/**
+ * @brief Draw a batch of pixels, merging neighbours into runs
+ * 
+ * Counting sort by row into a static index buffer, then an insertion sort
+ * by X that only has to fix up order within each row. The sort is stable,
+ * so of two identical points the later one is drawn last.
+ * 
+ * @param gfx Pointer to graphics context
+ * @param display Pointer to display driver instance
+ * @param pts Pixel coordinates
+ * @param colors Color of each pixel
+ * @param n Number of pixels
+ */
+void GFX_DrawPixels(GFX_t *gfx, void *display, const GFX_Point_t *pts, const uint16_t *colors, uint16_t n) {
+    static uint8_t order[GFX_PIXEL_BATCH];
+    
+    while (n) {
+        uint8_t m = (n > GFX_PIXEL_BATCH) ? GFX_PIXEL_BATCH : (uint8_t)n;
+        uint8_t i, j, b, sum = 0;
+        
+        // Points without a bucket are drawn singly; GFX_DrawPixel drops hidden ones
+        memset(pixel_rows, 0, sizeof(pixel_rows));
+        for (i = 0; i < m; i++) {
+            b = GFX_PixelBucket(gfx, &pts[i]);
+            if (b == GFX_SORT_ROWS) {
+                GFX_DrawPixel(gfx, display, pts[i].x, pts[i].y, colors[i]);
+            } else {
+                pixel_rows[b]++;
+            }
+        }
+        for (b = 0; b < GFX_SORT_ROWS; b++) {
+            uint8_t c = pixel_rows[b];
+            pixel_rows[b] = sum;
+            sum += c;
+        }
+        for (i = 0; i < m; i++) {
+            b = GFX_PixelBucket(gfx, &pts[i]);
+            if (b != GFX_SORT_ROWS) {
+                order[pixel_rows[b]++] = i;
+            }
+        }
+        
+        for (i = 1; i < sum; i++) {
+            uint8_t t = order[i];
+            for (j = i; (j > 0) && GFX_PixelAfter(&pts[order[j - 1]], &pts[t]); j--) {
+                order[j] = order[j - 1];
+            }
+            order[j] = t;
+        }
+        
+        GFX_PixelRuns(gfx, display, pts, colors, order, sum);
+        pts += m;
+        colors += m;
+        n -= m;
+    }
+}
+
+/**
+ * @brief Draw a batch of pixels, sorting the caller's arrays in place
+ * 
+ * American flag sort: rows are counted, then each point is swapped
+ * straight into its row's region, with visible points ahead of hidden
+ * ones. Rows are then put in X order by insertion sort. The only extra
+ * memory is one cursor per row.
+ * 
+ * @param gfx Pointer to graphics context
+ * @param display Pointer to display driver instance
+ * @param pts Pixel coordinates (reordered)
+ * @param colors Color of each pixel (reordered with pts)
+ * @param n Number of pixels
+ */
+void GFX_DrawPixelsInPlace(GFX_t *gfx, void *display, GFX_Point_t *pts, uint16_t *colors, uint16_t n) {
+    static uint8_t next[GFX_SORT_ROWS + 1];
+    
+    while (n) {
+        uint8_t m = (n > 255) ? 255 : (uint8_t)n;
+        uint8_t i, j, b, sum = 0;
+        
+        memset(pixel_rows, 0, sizeof(pixel_rows));
+        for (i = 0; i < m; i++) {
+            b = GFX_PixelBucket(gfx, &pts[i]);
+            if (b == GFX_SORT_ROWS) {
+                GFX_DrawPixel(gfx, display, pts[i].x, pts[i].y, colors[i]);
+            }
+            pixel_rows[b]++;
+        }
+        for (b = 0; b <= GFX_SORT_ROWS; b++) {
+            uint8_t c = pixel_rows[b];
+            pixel_rows[b] = next[b] = sum;
+            sum += c;
+        }
+        
+        // Swap each misplaced point into the next free slot of its row
+        for (b = 0; b < GFX_SORT_ROWS; b++) {
+            while (next[b] < pixel_rows[b + 1]) {
+                uint8_t c = GFX_PixelBucket(gfx, &pts[next[b]]);
+                if (c == b) {
+                    next[b]++;
+                } else {
+                    GFX_Point_t tp = pts[next[b]];
+                    uint16_t tc = colors[next[b]];
+                    pts[next[b]] = pts[next[c]];
+                    colors[next[b]] = colors[next[c]];
+                    pts[next[c]] = tp;
+                    colors[next[c]] = tc;
+                    next[c]++;
+                }
+            }
+        }
+        sum = pixel_rows[GFX_SORT_ROWS];
+        
+        for (i = 1; i < sum; i++) {
+            GFX_Point_t tp = pts[i];
+            uint16_t tc = colors[i];
+            for (j = i; (j > 0) && GFX_PixelAfter(&pts[j - 1], &tp); j--) {
+                pts[j] = pts[j - 1];
+                colors[j] = colors[j - 1];
+            }
+            pts[j] = tp;
+            colors[j] = tc;
+        }
+        
+        GFX_PixelRuns(gfx, display, pts, colors, NULL, sum);
+        pts += m;
+        colors += m;
+        n -= m;
     }
 }
 
@@ -249,9 +772,11 @@ void GFX_FillScreen(GFX_t *gfx, void *display, uint16_t color) {
 //==============================================================================
 
 /**
- * @brief Draw a line between two points using Bresenham's algorithm
+ * @brief Draw a line between two points
  * 
- * Handles lines in any direction using the classic line drawing algorithm.
+ * Clips the line to the clip rectangle first, then uses the
+ * hardware-accelerated function if available, otherwise falls back
+ * to GFX_WriteLine.
  * 
  * @param gfx Pointer to graphics context
  * @param display Pointer to display driver instance
@@ -262,7 +787,72 @@ void GFX_FillScreen(GFX_t *gfx, void *display, uint16_t color) {
  * @param color Line color
  */
 void GFX_DrawLine(GFX_t *gfx, void *display, int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint16_t color) {
-    int16_t steep = abs(y1 - y0) > abs(x1 - x0);
+    if (!GFX_ClipLine(gfx, &x0, &y0, &x1, &y1)) {
+        return;
+    }
+    if (GFX_HAS(gfx, drawLine)) {
+        GFX_CALL(gfx, drawLine)(display, x0, y0, x1, y1, color);
+    } else {
+        GFX_WriteLine(gfx, display, x0, y0, x1, y1, color);
+    }
+}
+
+/**
+ * @brief Draw one run of a software line
+ * 
+ * Uses the driver's span for the run's direction when it has one. The
+ * GFX_DrawFast*Line fallbacks draw through GFX_DrawLine, so without a
+ * span hook the run is drawn pixel by pixel instead.
+ * 
+ * @param gfx Pointer to graphics context
+ * @param display Pointer to display driver instance
+ * @param x X coordinate of the first pixel
+ * @param y Y coordinate of the first pixel
+ * @param len Pixels in the run
+ * @param vertical true for a run down a column, false along a row
+ * @param color Line color
+ */
+static void GFX_WriteRun(GFX_t *gfx, void *display, int16_t x, int16_t y, int16_t len, bool vertical, uint16_t color) {
+    if (len > 1) {
+        if (vertical && GFX_HAS(gfx, drawFastVLine)) {
+            GFX_DrawFastVLine(gfx, display, x, y, len, color);
+            return;
+        }
+        if (!vertical && GFX_HAS(gfx, drawFastHLine)) {
+            GFX_DrawFastHLine(gfx, display, x, y, len, color);
+            return;
+        }
+    }
+    for (; len > 0; len--) {
+        GFX_DrawPixel(gfx, display, x, y, color);
+        if (vertical) {
+            y++;
+        } else {
+            x++;
+        }
+    }
+}
+
+/**
+ * @brief Draw a line between two points using Bresenham's algorithm
+ * 
+ * Run-slice form of the classic algorithm: instead of stepping pixel by
+ * pixel, it works out how many pixels share each row (or column, for
+ * steep lines) and draws them as one span. Only the first run needs a
+ * division; after that every run is either q or q + 1 pixels long, with
+ * q = dx / dy, and the error term picks which. The pixels are exactly
+ * those of the pixel-stepping version.
+ * 
+ * @param gfx Pointer to graphics context
+ * @param display Pointer to display driver instance
+ * @param x0 Starting X coordinate
+ * @param y0 Starting Y coordinate
+ * @param x1 Ending X coordinate
+ * @param y1 Ending Y coordinate
+ * @param color Line color
+ */
+void GFX_WriteLine(GFX_t *gfx, void *display, int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint16_t color) {
+    bool steep = abs(y1 - y0) > abs(x1 - x0);
     
     if (steep) {
         GFX_Swap(&x0, &y0);
@@ -278,16 +868,35 @@ void GFX_DrawLine(GFX_t *gfx, void *display, int16_t x0, int16_t y0, int16_t x1,
     int16_t dy = abs(y1 - y0);
     int16_t err = dx / 2;
     int16_t ystep = (y0 < y1) ? 1 : -1;
+    int16_t q = dy ? dx / dy : 0;
+    int16_t qdy = q * dy;
+    
+    // The first run lasts until the initial error first drops below zero
+    int16_t run = dy ? (err / dy + 1) : (dx + 1);
+    err += dx - run * dy;
     
-    for (; x0 <= x1; x0++) {
+    for (;;) {
+        if (run > x1 - x0 + 1) {
+            run = x1 - x0 + 1;
+        }
         if (steep) {
-            GFX_DrawPixel(gfx, display, y0, x0, color);
+            GFX_WriteRun(gfx, display, y0, x0, run, true, color);
         } else {
-            GFX_DrawPixel(gfx, display, x0, y0, color);
+            GFX_WriteRun(gfx, display, x0, y0, run, false, color);
+        }
+        x0 += run;
+        if (x0 > x1) {
+            break;
         }
-        err -= dy;
-        if (err < 0) {
-            y0 += ystep;
+        y0 += ystep;
+        
+        // Middle runs are q or q + 1 pixels long
+        err -= qdy;
+        if (err >= 0) {
+            run = q + 1;
+            err += dx - dy;
+        } else {
+            run = q;
             err += dx;
         }
     }
@@ -306,8 +915,13 @@ void GFX_DrawLine(GFX_t *gfx, void *display, int16_t x0, int16_t y0, int16_t x1,
  * @param color Line color
  */
 void GFX_DrawFastVLine(GFX_t *gfx, void *display, int16_t x, int16_t y, int16_t h, uint16_t color) {
-    if (gfx->drawFastVLine) {
-        gfx->drawFastVLine(display, x, y, h, color);
+    int16_t w = 1;
+    
+    if (!GFX_ClipRect(gfx, &x, &y, &w, &h)) {
+        return;
+    }
+    if (GFX_HAS(gfx, drawFastVLine)) {
+        GFX_CALL(gfx, drawFastVLine)(display, x, y, h, color);
     } else {
         GFX_DrawLine(gfx, display, x, y, x, y + h - 1, color);
     }
@@ -326,8 +940,13 @@ void GFX_DrawFastVLine(GFX_t *gfx, void *display, int16_t x, int16_t y, int16_t
  * @param color Line color
  */
 void GFX_DrawFastHLine(GFX_t *gfx, void *display, int16_t x, int16_t y, int16_t w, uint16_t color) {
-    if (gfx->drawFastHLine) {
-        gfx->drawFastHLine(display, x, y, w, color);
+    int16_t h = 1;
+    
+    if (!GFX_ClipRect(gfx, &x, &y, &w, &h)) {
+        return;
+    }
+    if (GFX_HAS(gfx, drawFastHLine)) {
+        GFX_CALL(gfx, drawFastHLine)(display, x, y, w, color);
     } else {
         GFX_DrawLine(gfx, display, x, y, x + w - 1, y, color);
     }
@@ -340,7 +959,8 @@ void GFX_DrawFastHLine(GFX_t *gfx, void *display, int16_t x, int16_t y, int16_t
 /**
  * @brief Draw rectangle outline
  * 
- * Draws the four sides of a rectangle using fast line functions.
+ * Uses hardware-accelerated drawRect if available, otherwise draws the
+ * four sides of the rectangle using fast line functions.
  * 
  * @param gfx Pointer to graphics context
  * @param display Pointer to display driver instance
@@ -351,6 +971,18 @@ void GFX_DrawFastHLine(GFX_t *gfx, void *display, int16_t x, int16_t y, int16_t
  * @param color Outline color
  */
 void GFX_DrawRect(GFX_t *gfx, void *display, int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {
+    if (!GFX_BoxVisible(gfx, x, y, x + w - 1, y + h - 1)) {
+        return;
+    }
+    
+    // The hook only gets outlines that are entirely visible
+    if (GFX_HAS(gfx, drawRect) &&
+        (x >= gfx->clip.x0) && (y >= gfx->clip.y0) &&
+        (x + w - 1 <= gfx->clip.x1) && (y + h - 1 <= gfx->clip.y1)) {
+        GFX_CALL(gfx, drawRect)(display, x, y, w, h, color);
+        return;
+    }
+    
     GFX_DrawFastHLine(gfx, display, x, y, w, color);             // Top edge
     GFX_DrawFastHLine(gfx, display, x, y + h - 1, w, color);     // Bottom edge
     GFX_DrawFastVLine(gfx, display, x, y, h, color);             // Left edge
@@ -360,7 +992,8 @@ void GFX_DrawRect(GFX_t *gfx, void *display, int16_t x, int16_t y, int16_t w, in
 /**
  * @brief Fill a rectangle with specified color
  * 
- * Uses hardware-optimized fillRect if available, otherwise draws vertical lines.
+ * Trims the rectangle to the clip rectangle once, then uses
+ * hardware-optimized fillRect if available, otherwise draws vertical lines.
  * 
  * @param gfx Pointer to graphics context
  * @param display Pointer to display driver instance
@@ -371,8 +1004,11 @@ void GFX_DrawRect(GFX_t *gfx, void *display, int16_t x, int16_t y, int16_t w, in
  * @param color Fill color
  */
 void GFX_FillRect(GFX_t *gfx, void *display, int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {
-    if (gfx->fillRect) {
-        gfx->fillRect(display, x, y, w, h, color);
+    if (!GFX_ClipRect(gfx, &x, &y, &w, &h)) {
+        return;
+    }
+    if (GFX_HAS(gfx, fillRect)) {
+        GFX_CALL(gfx, fillRect)(display, x, y, w, h, color);
     } else {
         // Fallback: draw vertical lines to fill rectangle
         for (int16_t i = x; i < x + w; i++) {
@@ -407,69 +1043,624 @@ void GFX_DrawTriangle(GFX_t *gfx, void *display, int16_t x0, int16_t y0, int16_t
 }
 
 /**
- * @brief Fill a triangle with specified color
- * 
- * Uses scan-line filling algorithm to fill triangle efficiently.
- * Sorts vertices by Y coordinate and fills between edges.
+ * @brief Edge of a filled triangle, stepped one row at a time
  * 
- * @param gfx Pointer to graphics context
- * @param display Pointer to display driver instance
- * @param x0 X coordinate of first vertex
- * @param y0 Y coordinate of first vertex
- * @param x1 X coordinate of second vertex
- * @param y1 Y coordinate of second vertex
- * @param x2 X coordinate of third vertex
- * @param y2 Y coordinate of third vertex
+ * Holds the edge's X crossing on the current row, rounded either up or
+ * towards the top vertex's column, and the remainder
+ * r = t * dx - (x - x_top) * dy, which stays within (-dy, dy). The slope
+ * is split once into a whole step and a remainder, so rows are stepped
+ * with additions only.
+ */
+typedef struct {
+    int16_t x;      ///< Pixel column of the rounded crossing
+    int16_t r;      ///< Remainder of the crossing, in 1/dy units
+    int16_t step;   ///< Whole columns moved per row
+    int16_t rem;    ///< dx - step * dy
+    int16_t dy;     ///< Rows from top to bottom vertex (> 0)
+} GFX_TriEdge_t;
+
+/**
+ * @brief Start a triangle edge at its top vertex
+ * @param e Edge to initialise
+ * @param xa X of the top vertex
+ * @param ya Y of the top vertex
+ * @param xb X of the bottom vertex
+ * @param yb Y of the bottom vertex
+ * @param up true to round crossings up, false to round them towards xa
+ */
+static void GFX_TriEdgeInit(GFX_TriEdge_t *e, int16_t xa, int16_t ya, int16_t xb, int16_t yb, bool up) {
+    int16_t dx = xb - xa;
+    
+    e->x = xa;
+    e->r = 0;
+    e->dy = yb - ya;
+    e->step = dx / e->dy;
+    e->rem = dx - e->step * e->dy;
+    if (up && (e->rem > 0)) {
+        e->step++;
+        e->rem -= e->dy;
+    }
+}
+
+/**
+ * @brief Advance a triangle edge to the next row
+ * @param e Edge to step
+ */
+static void GFX_TriEdgeStep(GFX_TriEdge_t *e) {
+    e->x += e->step;
+    e->r += e->rem;
+    if (e->r <= -e->dy) {
+        e->x--;
+        e->r += e->dy;
+    } else if (e->r >= e->dy) {
+        e->x++;
+        e->r -= e->dy;
+    }
+}
+
+/**
+ * @brief Fill a triangle with specified color
+ * 
+ * Every pixel on or inside the outline is filled, the same coverage as
+ * the classic Adafruit fill, so an outline drawn over it lines up and
+ * degenerate triangles still show as a line. Edges are stepped
+ * incrementally, so the only divisions are one 16-bit divide per edge.
+ * 
+ * @param gfx Pointer to graphics context
+ * @param display Pointer to display driver instance
+ * @param x0 X coordinate of first vertex
+ * @param y0 Y coordinate of first vertex
+ * @param x1 X coordinate of second vertex
+ * @param y1 Y coordinate of second vertex
+ * @param x2 X coordinate of third vertex
+ * @param y2 Y coordinate of third vertex
  * @param color Fill color
  */
 void GFX_FillTriangle(GFX_t *gfx, void *display, int16_t x0, int16_t y0, int16_t x1, int16_t y1, int16_t x2, int16_t y2, uint16_t color) {
-    int16_t a, b, y, last;
+    GFX_TriEdge_t lng, shrt;
+    int16_t a, b, y, last, split;
     
     // Sort vertices by Y coordinate (y0 <= y1 <= y2)
     if (y0 > y1) { GFX_Swap(&y0, &y1); GFX_Swap(&x0, &x1); }
     if (y1 > y2) { GFX_Swap(&y2, &y1); GFX_Swap(&x2, &x1); }
     if (y0 > y1) { GFX_Swap(&y0, &y1); GFX_Swap(&x0, &x1); }
     
+    if (!GFX_BoxVisible(gfx, min(x0, min(x1, x2)), y0, max(x0, max(x1, x2)), y2)) {
+        return;
+    }
+    
     // Handle degenerate case (horizontal line)
     if (y0 == y2) {
-        a = b = x0;
-        if (x1 < a) a = x1;
-        else if (x1 > b) b = x1;
-        if (x2 < a) a = x2;
-        else if (x2 > b) b = x2;
+        a = min(x0, min(x1, x2));
+        b = max(x0, max(x1, x2));
         GFX_DrawFastHLine(gfx, display, a, y0, b - a + 1, color);
         return;
     }
     
-    // Calculate edge deltas
-    int16_t dx01 = x1 - x0, dy01 = y1 - y0, dx02 = x2 - x0, dy02 = y2 - y0,
-            dx12 = x2 - x1, dy12 = y2 - y1;
-    int32_t sa = 0, sb = 0;
+    // The short edge switches to v1-v2 after the upper part; a flat
+    // bottom row belongs to the upper part, a flat top row to the lower
+    split = (y1 == y2) ? y1 + 1 : y1;
+    GFX_TriEdgeInit(&lng, x0, y0, x2, y2, false);
+    if (y0 < y1) {
+        GFX_TriEdgeInit(&shrt, x0, y0, x1, y1, false);
+    } else {
+        GFX_TriEdgeInit(&shrt, x1, y1, x2, y2, false);
+    }
     
-    // Fill upper part of triangle
-    if (y1 == y2) last = y1;
-    else last = y1 - 1;
+    last = min(y2, gfx->clip.y1);
     
     for (y = y0; y <= last; y++) {
-        a = x0 + (int16_t)(sa / dy01);
-        b = x0 + (int16_t)(sb / dy02);
-        sa += dx01;
-        sb += dx02;
-        if (a > b) GFX_Swap(&a, &b);
-        GFX_DrawFastHLine(gfx, display, a, y, b - a + 1, color);
+        if (y == split) {
+            GFX_TriEdgeInit(&shrt, x1, y1, x2, y2, false);
+        }
+        if (y >= gfx->clip.y0) {
+            a = min(shrt.x, lng.x);
+            b = max(shrt.x, lng.x);
+            GFX_DrawFastHLine(gfx, display, a, y, b - a + 1, color);
+        }
+        GFX_TriEdgeStep(&lng);
+        GFX_TriEdgeStep(&shrt);
+    }
+}
+
+/**
+ * @brief Fill a triangle following the top-left rule
+ * 
+ * A pixel centre on a left or top edge is inside, one on a right or
+ * bottom edge is not, and triangles with no area draw nothing. Triangles
+ * that share an edge therefore tile a mesh without overlap or gaps.
+ * Edges are rounded up and stepped incrementally, so the only divisions
+ * are one 16-bit divide per edge.
+ * 
+ * @param gfx Pointer to graphics context
+ * @param display Pointer to display driver instance
+ * @param x0 X coordinate of first vertex
+ * @param y0 Y coordinate of first vertex
+ * @param x1 X coordinate of second vertex
+ * @param y1 Y coordinate of second vertex
+ * @param x2 X coordinate of third vertex
+ * @param y2 Y coordinate of third vertex
+ * @param color Fill color
+ */
+void GFX_FillTriangleTopLeft(GFX_t *gfx, void *display, int16_t x0, int16_t y0, int16_t x1, int16_t y1, int16_t x2, int16_t y2, uint16_t color) {
+    GFX_TriEdge_t lng, shrt;
+    GFX_TriEdge_t *left, *right;
+    int16_t y, last;
+    int32_t side;
+    
+    // Sort vertices by Y coordinate (y0 <= y1 <= y2)
+    if (y0 > y1) { GFX_Swap(&y0, &y1); GFX_Swap(&x0, &x1); }
+    if (y1 > y2) { GFX_Swap(&y2, &y1); GFX_Swap(&x2, &x1); }
+    if (y0 > y1) { GFX_Swap(&y0, &y1); GFX_Swap(&x0, &x1); }
+    
+    if (!GFX_BoxVisible(gfx, min(x0, min(x1, x2)), y0, max(x0, max(x1, x2)), y2)) {
+        return;
+    }
+    
+    // Which side of the long edge (v0-v2) the middle vertex lies on
+    side = (int32_t)(x1 - x0) * (y2 - y0) - (int32_t)(x2 - x0) * (y1 - y0);
+    if (side == 0) {
+        return;
+    }
+    
+    // The short edge switches to v1-v2 on row y1, or starts there for a flat top
+    GFX_TriEdgeInit(&lng, x0, y0, x2, y2, true);
+    if (y0 < y1) {
+        GFX_TriEdgeInit(&shrt, x0, y0, x1, y1, true);
+    } else {
+        GFX_TriEdgeInit(&shrt, x1, y1, x2, y2, true);
+    }
+    left = (side > 0) ? &lng : &shrt;
+    right = (side > 0) ? &shrt : &lng;
+    
+    // The bottom row only holds a vertex or a bottom edge, so it is never filled
+    last = min(y2 - 1, gfx->clip.y1);
+    
+    for (y = y0; y <= last; y++) {
+        if (y == y1) {
+            GFX_TriEdgeInit(&shrt, x1, y1, x2, y2, true);
+        }
+        if ((y >= gfx->clip.y0) && (right->x > left->x)) {
+            GFX_DrawFastHLine(gfx, display, left->x, y, right->x - left->x, color);
+        }
+        GFX_TriEdgeStep(&lng);
+        GFX_TriEdgeStep(&shrt);
+    }
+}
+
+//==============================================================================
+// POLYGON FUNCTIONS
+//==============================================================================
+
+/**
+ * @brief Polygon edge in the scanline edge table
+ * 
+ * The crossing on the current row is kept as the mixed number x + err / dy
+ * and stepped with a whole part and a remainder, so rows need no divide.
+ */
+typedef struct {
+    int16_t ytop;   ///< First row the edge crosses
+    int16_t ybot;   ///< Last row the edge crosses
+    int16_t x;      ///< Crossing on the current row, rounded to nearest
+    int16_t err;    ///< Fraction of the crossing in 1/dy units (0..dy-1)
+    int16_t step;   ///< Whole pixels the crossing moves per row
+    int16_t rem;    ///< Fraction the crossing moves per row (0..dy-1)
+    int16_t dy;     ///< Edge height in rows
+    int8_t dir;     ///< +1 if the edge runs downwards, -1 if upwards
+} GFX_Edge_t;
+
+/**
+ * @brief Check whether the outline keeps going down past a vertex
+ * 
+ * Follows the outline from the bottom vertex of an edge, skipping
+ * horizontal edges, and reports whether the next sloped edge continues
+ * downwards. Such edges end one row early so the shared row is only
+ * crossed once; at a local minimum both edges keep their last row.
+ * 
+ * @param points Polygon vertices
+ * @param n Number of vertices
+ * @param v Index of the bottom vertex
+ * @param fwd true to follow the outline in vertex order, false backwards
+ * @return true if the outline continues below the vertex
+ */
+static bool GFX_PolyContinues(const GFX_Point_t *points, uint8_t n, uint8_t v, bool fwd) {
+    int16_t y = points[v].y;
+    
+    for (;;) {
+        v = fwd ? ((v + 1 == n) ? 0 : v + 1) : ((v == 0) ? n - 1 : v - 1);
+        if (points[v].y != y) {
+            return points[v].y > y;
+        }
+    }
+}
+
+/**
+ * @brief Fill a polygon with specified color
+ * 
+ * Active-edge-table scanline fill. Edges are sorted by their top row and
+ * join the active list when the scan reaches them; each row the active
+ * crossings are put in X order and the spans between them are drawn with
+ * DrawFastHLine. Crossings are stepped as fixed-point DDAs, so the only
+ * divisions are made once per edge.
+ * 
+ * @param gfx Pointer to graphics context
+ * @param display Pointer to display driver instance
+ * @param points Array of vertices
+ * @param n Number of vertices
+ * @param rule GFX_FILL_EVEN_ODD or GFX_FILL_NONZERO
+ * @param color Fill color
+ */
+void GFX_FillPolygon(GFX_t *gfx, void *display, const GFX_Point_t *points, uint8_t n, uint8_t rule, uint16_t color) {
+    static GFX_Edge_t edges[GFX_POLY_EDGES];
+    uint8_t active[GFX_POLY_EDGES];
+    uint8_t i, j, ne = 0, na = 0, next = 0;
+    int16_t xmin, xmax, ymin, ymax, y, ylast;
+    
+    if ((n < 3) || (n > GFX_POLY_EDGES)) return;
+    
+    xmin = xmax = points[0].x;
+    ymin = ymax = points[0].y;
+    for (i = 1; i < n; i++) {
+        xmin = min(xmin, points[i].x);
+        xmax = max(xmax, points[i].x);
+        ymin = min(ymin, points[i].y);
+        ymax = max(ymax, points[i].y);
+    }
+    if (!GFX_BoxVisible(gfx, xmin, ymin, xmax, ymax)) {
+        return;
+    }
+    
+    y = max(ymin, gfx->clip.y0);
+    ylast = min(ymax, gfx->clip.y1);
+    
+    // Build the edge table sorted by top row
+    for (i = 0; i < n; i++) {
+        uint8_t k = (i + 1 == n) ? 0 : i + 1;
+        const GFX_Point_t *a = &points[i], *b = &points[k];
+        GFX_Edge_t e;
+        int16_t dx;
+        
+        // Horizontal edges add no crossings but are part of the outline
+        if (a->y == b->y) {
+            GFX_DrawFastHLine(gfx, display, min(a->x, b->x), a->y, abs(b->x - a->x) + 1, color);
+            continue;
+        }
+        
+        if (a->y < b->y) {
+            e.dir = 1;
+            e.ybot = b->y - (GFX_PolyContinues(points, n, k, true) ? 1 : 0);
+        } else {
+            const GFX_Point_t *t = a;
+            a = b;
+            b = t;
+            e.dir = -1;
+            e.ybot = b->y - (GFX_PolyContinues(points, n, i, false) ? 1 : 0);
+        }
+        if ((e.ybot < y) || (a->y > ylast)) continue;
+        
+        e.dy = b->y - a->y;
+        dx = b->x - a->x;
+        e.step = dx / e.dy;
+        e.rem = dx % e.dy;
+        if (e.rem < 0) {
+            e.step--;
+            e.rem += e.dy;
+        }
+        
+        // Start at the top vertex, or at the first visible row
+        e.ytop = a->y;
+        e.x = a->x;
+        e.err = e.dy / 2;
+        if (e.ytop < y) {
+            int32_t num = (int32_t)(y - e.ytop) * dx + e.dy / 2;
+            int16_t q = (int16_t)(num / e.dy);
+            int16_t r = (int16_t)(num % e.dy);
+            if (r < 0) {
+                q--;
+                r += e.dy;
+            }
+            e.x += q;
+            e.err = r;
+            e.ytop = y;
+        }
+        
+        for (j = ne++; (j > 0) && (edges[j - 1].ytop > e.ytop); j--) {
+            edges[j] = edges[j - 1];
+        }
+        edges[j] = e;
+    }
+    
+    for (; y <= ylast; y++) {
+        int16_t start = 0;
+        int8_t wind = 0;
+        
+        // Add edges that begin on this row and drop the ones that have ended
+        while ((next < ne) && (edges[next].ytop == y)) {
+            active[na++] = next++;
+        }
+        for (i = j = 0; i < na; i++) {
+            if (edges[active[i]].ybot >= y) {
+                active[j++] = active[i];
+            }
+        }
+        na = j;
+        
+        // Crossings move little from row to row, so insertion sort is cheap
+        for (i = 1; i < na; i++) {
+            uint8_t t = active[i];
+            for (j = i; (j > 0) && (edges[active[j - 1]].x > edges[t].x); j--) {
+                active[j] = active[j - 1];
+            }
+            active[j] = t;
+        }
+        
+        for (i = 0; i < na; i++) {
+            GFX_Edge_t *e = &edges[active[i]];
+            bool was = (rule == GFX_FILL_NONZERO) ? (wind != 0) : (wind & 1);
+            bool is;
+            
+            wind += e->dir;
+            is = (rule == GFX_FILL_NONZERO) ? (wind != 0) : (wind & 1);
+            if (!was && is) {
+                start = e->x;
+            } else if (was && !is) {
+                GFX_DrawFastHLine(gfx, display, start, y, e->x - start + 1, color);
+            }
+            
+            // Step to the next row
+            e->x += e->step;
+            e->err += e->rem;
+            if (e->err >= e->dy) {
+                e->x++;
+                e->err -= e->dy;
+            }
+        }
     }
+}
+
+//==============================================================================
+// THICK AND ANTI-ALIASED LINES
+//==============================================================================
+
+/**
+ * @brief Integer square root
+ * @param n Value
+ * @return floor(sqrt(n))
+ */
+static uint16_t GFX_ISqrt(uint32_t n) {
+    uint32_t root = 0;
+    uint32_t bit = 1UL << 30;
     
-    // Fill lower part of triangle
-    sa = (int32_t)dx12 * (y - y1);
-    sb = (int32_t)dx02 * (y - y0);
+    while (bit > n) {
+        bit >>= 2;
+    }
+    while (bit) {
+        if (n >= root + bit) {
+            n -= root + bit;
+            root = (root >> 1) + bit;
+        } else {
+            root >>= 1;
+        }
+        bit >>= 2;
+    }
+    return (uint16_t)root;
+}
+
+/**
+ * @brief Divide, rounding to nearest with halves away from zero
+ * @param n Numerator
+ * @param d Denominator (> 0)
+ * @return n / d rounded
+ */
+static int16_t GFX_RoundDiv(int32_t n, int32_t d) {
+    return (int16_t)((n >= 0) ? (n + d / 2) / d : -((-n + d / 2) / d));
+}
+
+/**
+ * @brief Draw a line of a given width
+ * 
+ * The line is widened into a quadrilateral along its normal and filled
+ * with the polygon scanline fill, so every row goes out as one span. The
+ * normal is scaled with an integer square root of the squared length.
+ * Ends are square and do not extend past the endpoints.
+ * 
+ * @param gfx Pointer to graphics context
+ * @param display Pointer to display driver instance
+ * @param x0 X coordinate of start point
+ * @param y0 Y coordinate of start point
+ * @param x1 X coordinate of end point
+ * @param y1 Y coordinate of end point
+ * @param width Line width in pixels
+ * @param color Line color
+ */
+void GFX_DrawThickLine(GFX_t *gfx, void *display, int16_t x0, int16_t y0, int16_t x1, int16_t y1,
+                       int16_t width, uint16_t color) {
+    GFX_Point_t p[4];
+    int16_t dx = x1 - x0;
+    int16_t dy = y1 - y0;
+    int16_t a = (width - 1) / 2;    // Pixels on the left of the centre line
+    int16_t b = width / 2;          // Pixels on the right of the centre line
+    uint32_t len2;
+    int32_t len;                    // Line length in 1/16 pixels
     
-    for (; y <= y2; y++) {
-        a = x1 + (int16_t)(sa / dy12);
-        b = x0 + (int16_t)(sb / dy02);
-        sa += dx12;
-        sb += dx02;
-        if (a > b) GFX_Swap(&a, &b);
-        GFX_DrawFastHLine(gfx, display, a, y, b - a + 1, color);
+    if (width <= 1) {
+        if (width == 1) {
+            GFX_DrawLine(gfx, display, x0, y0, x1, y1, color);
+        }
+        return;
+    }
+    if ((dx == 0) && (dy == 0)) {
+        GFX_FillRect(gfx, display, x0 - a, y0 - a, width, width, color);
+        return;
+    }
+    
+    len2 = (uint32_t)((int32_t)dx * dx) + (uint32_t)((int32_t)dy * dy);
+    len = (len2 < 0x01000000UL) ? GFX_ISqrt(len2 << 8) : ((int32_t)GFX_ISqrt(len2) << 4);
+    
+    // Offset the two sides along the unit normal (-dy, dx) / len
+    p[0].x = x0 + GFX_RoundDiv((int32_t)dy * a * 16, len);
+    p[0].y = y0 - GFX_RoundDiv((int32_t)dx * a * 16, len);
+    p[3].x = x0 - GFX_RoundDiv((int32_t)dy * b * 16, len);
+    p[3].y = y0 + GFX_RoundDiv((int32_t)dx * b * 16, len);
+    p[1].x = p[0].x + dx;
+    p[1].y = p[0].y + dy;
+    p[2].x = p[3].x + dx;
+    p[2].y = p[3].y + dy;
+    GFX_FillPolygon(gfx, display, p, 4, GFX_FILL_EVEN_ODD, color);
+}
+
+/**
+ * @brief Send a block of anti-aliased line pixels
+ * 
+ * The block is two pixels across the line and len pixels along it, held
+ * in the row buffer in stream order for a single address window: two
+ * half-buffer rows for a shallow line, interleaved pairs for a steep one.
+ * The block is cut to the clip rectangle; only a steep block with one
+ * hidden column has to fall back to single pixels.
+ * 
+ * @param gfx Pointer to graphics context
+ * @param display Pointer to display driver instance
+ * @param x X coordinate of the block's top-left pixel
+ * @param y Y coordinate of the block's top-left pixel
+ * @param len Pixels along the line
+ * @param steep true if the line runs down columns
+ */
+static void GFX_LineAAFlush(GFX_t *gfx, void *display, int16_t x, int16_t y, int16_t len, bool steep) {
+    int16_t w = steep ? 2 : len;
+    int16_t h = steep ? len : 2;
+    int16_t cx = x, cy = y, cw = w, ch = h;
+    int16_t i, j;
+    
+    if (!GFX_ClipRect(gfx, &cx, &cy, &cw, &ch)) {
+        return;
+    }
+    if (GFX_HAS(gfx, setAddrWindow) && GFX_HAS(gfx, writePixels)) {
+        if (!steep) {
+            GFX_CALL(gfx, setAddrWindow)(display, cx, cy, cw, ch);
+            for (j = cy - y; j < cy - y + ch; j++) {
+                GFX_CALL(gfx, writePixels)(display, &row_buffer[j * (GFX_LINE_PIXELS / 2) + cx - x], cw);
+            }
+            return;
+        }
+        if (cw == 2) {
+            GFX_CALL(gfx, setAddrWindow)(display, cx, cy, 2, ch);
+            GFX_CALL(gfx, writePixels)(display, &row_buffer[2 * (cy - y)], 2 * ch);
+            return;
+        }
+    }
+    if (!GFX_HAS(gfx, drawPixel)) {
+        return;
+    }
+    for (j = cy; j < cy + ch; j++) {
+        for (i = cx; i < cx + cw; i++) {
+            GFX_CALL(gfx, drawPixel)(display, i, j,
+                row_buffer[steep ? 2 * (j - y) + (i - x) : (j - y) * (GFX_LINE_PIXELS / 2) + (i - x)]);
+        }
+    }
+}
+
+/**
+ * @brief Draw an anti-aliased line over a known background
+ * 
+ * Wu's algorithm with Abrash's 16-bit error accumulator: each step along
+ * the major axis lights the two pixels straddling the ideal line, with
+ * the fractional position splitting the color between them. Shades are
+ * blended against bgcolor once per line into a small table. Consecutive
+ * steps that share a pixel pair position are sent as one 2-pixel-wide
+ * block. Horizontal, vertical and 45-degree lines need no smoothing and
+ * are drawn with GFX_DrawLine.
+ * 
+ * @param gfx Pointer to graphics context
+ * @param display Pointer to display driver instance
+ * @param x0 X coordinate of start point
+ * @param y0 Y coordinate of start point
+ * @param x1 X coordinate of end point
+ * @param y1 Y coordinate of end point
+ * @param color Line color
+ * @param bgcolor Background color the line is blended against
+ */
+void GFX_DrawLineAA(GFX_t *gfx, void *display, int16_t x0, int16_t y0, int16_t x1, int16_t y1,
+                    uint16_t color, uint16_t bgcolor) {
+    uint16_t shade[GFX_AA_LEVELS + 1];
+    bool steep = abs(y1 - y0) > abs(x1 - x0);
+    int16_t u0, u1, v, du, dv, vdir, u, start = 0, base = 0, len = 0;
+    uint16_t acc = 0, adj, prev;
+    uint8_t i, w, slot_near, slot_far;
+    
+    if (steep) {
+        u0 = y0;
+        u1 = y1;
+        v = x0;
+        dv = x1 - x0;
+    } else {
+        u0 = x0;
+        u1 = x1;
+        v = y0;
+        dv = y1 - y0;
+    }
+    if (u0 > u1) {
+        GFX_Swap(&x0, &x1);
+        GFX_Swap(&y0, &y1);
+        GFX_Swap(&u0, &u1);
+        v = steep ? x0 : y0;
+        dv = -dv;
+    }
+    du = u1 - u0;
+    vdir = (dv < 0) ? -1 : 1;
+    dv = abs(dv);
+    if ((dv == 0) || (dv == du)) {
+        GFX_DrawLine(gfx, display, x0, y0, x1, y1, color);
+        return;
+    }
+    if (!GFX_BoxVisible(gfx, min(x0, x1) - 1, min(y0, y1) - 1, max(x0, x1) + 1, max(y0, y1) + 1)) {
+        return;
+    }
+    
+    for (i = 0; i <= GFX_AA_LEVELS; i++) {
+        shade[i] = GFX_Blend565(color, bgcolor, (uint8_t)(i * (32 / GFX_AA_LEVELS)));
+    }
+    GFX_DrawPixel(gfx, display, x0, y0, color);
+    GFX_DrawPixel(gfx, display, x1, y1, color);
+    
+    // Row buffer slots of the pixel nearer the line, and of its neighbour
+    slot_near = (vdir > 0) ? 0 : 1;
+    slot_far = 1 - slot_near;
+    adj = (uint16_t)(((uint32_t)dv << 16) / du);
+    for (u = u0 + 1; u < u1; u++) {
+        prev = acc;
+        acc += adj;
+        if (acc <= prev) {
+            v += vdir;
+        }
+        if ((len == GFX_LINE_PIXELS / 2) || (len && (v != base))) {
+            if (steep) {
+                GFX_LineAAFlush(gfx, display, min(base, base + vdir), start, len, true);
+            } else {
+                GFX_LineAAFlush(gfx, display, start, min(base, base + vdir), len, false);
+            }
+            len = 0;
+        }
+        if (len == 0) {
+            start = u;
+            base = v;
+        }
+        
+        w = (uint8_t)(acc >> (16 - GFX_AA_SHIFT));
+        if (steep) {
+            row_buffer[2 * len + slot_near] = shade[GFX_AA_LEVELS - w];
+            row_buffer[2 * len + slot_far] = shade[w];
+        } else {
+            row_buffer[slot_near * (GFX_LINE_PIXELS / 2) + len] = shade[GFX_AA_LEVELS - w];
+            row_buffer[slot_far * (GFX_LINE_PIXELS / 2) + len] = shade[w];
+        }
+        len++;
+    }
+    if (len) {
+        if (steep) {
+            GFX_LineAAFlush(gfx, display, min(base, base + vdir), start, len, true);
+        } else {
+            GFX_LineAAFlush(gfx, display, start, min(base, base + vdir), len, false);
+        }
     }
 }
 
@@ -478,32 +1669,97 @@ void GFX_FillTriangle(GFX_t *gfx, void *display, int16_t x0, int16_t y0, int16_t
 //==============================================================================
 
 /**
- * @brief Draw circle outline using Bresenham's circle algorithm
+ * @brief Draw one run of an outline arc into each selected quadrant
  * 
- * Draws 8-way symmetric circle using integer arithmetic.
+ * The run covers octant points (xs..xe, y). Each quadrant mirrors it into
+ * a horizontal span (its flat octant) and a vertical span (its steep one).
  * 
  * @param gfx Pointer to graphics context
  * @param display Pointer to display driver instance
- * @param x0 X coordinate of center
- * @param y0 Y coordinate of center
- * @param r Circle radius
+ * @param xl Centre X of the left quadrants
+ * @param xr Centre X of the right quadrants
+ * @param yt Centre Y of the top quadrants
+ * @param yb Centre Y of the bottom quadrants
+ * @param xs First X offset of the run
+ * @param xe Last X offset of the run
+ * @param y Y offset of the run
+ * @param corners Quadrant bitmask (1 TL, 2 TR, 4 BR, 8 BL)
  * @param color Outline color
  */
-void GFX_DrawCircle(GFX_t *gfx, void *display, int16_t x0, int16_t y0, int16_t r, uint16_t color) {
+static void GFX_ArcRun(GFX_t *gfx, void *display, int16_t xl, int16_t xr, int16_t yt, int16_t yb,
+                       int16_t xs, int16_t xe, int16_t y, uint8_t corners, uint16_t color) {
+    int16_t n = xe - xs + 1;
+    
+    if (corners & 0x4) { // Bottom right
+        GFX_WriteRun(gfx, display, xr + xs, yb + y, n, false, color);
+        GFX_WriteRun(gfx, display, xr + y, yb + xs, n, true, color);
+    }
+    if (corners & 0x2) { // Top right
+        GFX_WriteRun(gfx, display, xr + xs, yt - y, n, false, color);
+        GFX_WriteRun(gfx, display, xr + y, yt - xe, n, true, color);
+    }
+    if (corners & 0x8) { // Bottom left
+        GFX_WriteRun(gfx, display, xl - y, yb + xs, n, true, color);
+        GFX_WriteRun(gfx, display, xl - xe, yb + y, n, false, color);
+    }
+    if (corners & 0x1) { // Top left
+        GFX_WriteRun(gfx, display, xl - y, yt - xe, n, true, color);
+        GFX_WriteRun(gfx, display, xl - xe, yt - y, n, false, color);
+    }
+}
+
+/**
+ * @brief Draw quarter-circle outlines as runs, in one midpoint pass
+ * 
+ * Walks one octant with the midpoint algorithm and collects consecutive
+ * points that share a Y offset into runs, which are mirrored into the
+ * selected quadrants as spans. The quadrants may have different centres,
+ * so the four corners of a rounded rectangle share one pass.
+ * 
+ * With join set (all four quadrants), the runs through the cardinal
+ * points are also drawn, merged with the straight sides between the
+ * centres into single spans: the full outline of a circle or rounded
+ * rectangle.
+ * 
+ * @param gfx Pointer to graphics context
+ * @param display Pointer to display driver instance
+ * @param xl Centre X of the left quadrants
+ * @param xr Centre X of the right quadrants
+ * @param yt Centre Y of the top quadrants
+ * @param yb Centre Y of the bottom quadrants
+ * @param r Radius
+ * @param corners Quadrant bitmask (1 TL, 2 TR, 4 BR, 8 BL)
+ * @param join true to include the cardinal runs and straight sides
+ * @param color Outline color
+ */
+static void GFX_CircleRuns(GFX_t *gfx, void *display, int16_t xl, int16_t xr, int16_t yt, int16_t yb,
+                           int16_t r, uint8_t corners, bool join, uint16_t color) {
     int16_t f = 1 - r;
     int16_t ddF_x = 1;
     int16_t ddF_y = -2 * r;
     int16_t x = 0;
     int16_t y = r;
+    int16_t xs = join ? 0 : 1;  // First X offset of the run on row y
     
-    // Draw cardinal points
-    GFX_DrawPixel(gfx, display, x0, y0 + r, color);
-    GFX_DrawPixel(gfx, display, x0, y0 - r, color);
-    GFX_DrawPixel(gfx, display, x0 + r, y0, color);
-    GFX_DrawPixel(gfx, display, x0 - r, y0, color);
-    
-    // Draw octants
-    while (x < y) {
+    for (;;) {
+        bool last = (x >= y);
+        
+        // Flush the run when the row changes or the octant ends
+        if (last || (f >= 0)) {
+            if (join && (xs == 0)) {
+                GFX_WriteRun(gfx, display, xl - x, yt - y, xr - xl + 1 + 2 * x, false, color);
+                GFX_WriteRun(gfx, display, xl - x, yb + y, xr - xl + 1 + 2 * x, false, color);
+                GFX_WriteRun(gfx, display, xl - y, yt - x, yb - yt + 1 + 2 * x, true, color);
+                GFX_WriteRun(gfx, display, xr + y, yt - x, yb - yt + 1 + 2 * x, true, color);
+            } else if (x >= xs) {
+                GFX_ArcRun(gfx, display, xl, xr, yt, yb, xs, x, y, corners, color);
+            }
+            xs = x + 1;
+        }
+        if (last) {
+            break;
+        }
+        
         if (f >= 0) {
             y--;
             ddF_y += 2;
@@ -512,19 +1768,29 @@ void GFX_DrawCircle(GFX_t *gfx, void *display, int16_t x0, int16_t y0, int16_t r
         x++;
         ddF_x += 2;
         f += ddF_x;
-        
-        // Draw 8 symmetric points
-        GFX_DrawPixel(gfx, display, x0 + x, y0 + y, color);
-        GFX_DrawPixel(gfx, display, x0 - x, y0 + y, color);
-        GFX_DrawPixel(gfx, display, x0 + x, y0 - y, color);
-        GFX_DrawPixel(gfx, display, x0 - x, y0 - y, color);
-        GFX_DrawPixel(gfx, display, x0 + y, y0 + x, color);
-        GFX_DrawPixel(gfx, display, x0 - y, y0 + x, color);
-        GFX_DrawPixel(gfx, display, x0 + y, y0 - x, color);
-        GFX_DrawPixel(gfx, display, x0 - y, y0 - x, color);
     }
 }
 
+/**
+ * @brief Draw circle outline using Bresenham's circle algorithm
+ * 
+ * Draws 8-way symmetric circle using integer arithmetic. Consecutive
+ * pixels of each octant are drawn as one horizontal or vertical span.
+ * 
+ * @param gfx Pointer to graphics context
+ * @param display Pointer to display driver instance
+ * @param x0 X coordinate of center
+ * @param y0 Y coordinate of center
+ * @param r Circle radius
+ * @param color Outline color
+ */
+void GFX_DrawCircle(GFX_t *gfx, void *display, int16_t x0, int16_t y0, int16_t r, uint16_t color) {
+    if (!GFX_BoxVisible(gfx, x0 - r, y0 - r, x0 + r, y0 + r)) {
+        return;
+    }
+    GFX_CircleRuns(gfx, display, x0, x0, y0, y0, r, 0xF, true, color);
+}
+
 /**
  * @brief Fill a circle with specified color
  * 
@@ -538,6 +1804,9 @@ void GFX_DrawCircle(GFX_t *gfx, void *display, int16_t x0, int16_t y0, int16_t r
  * @param color Fill color
  */
 void GFX_FillCircle(GFX_t *gfx, void *display, int16_t x0, int16_t y0, int16_t r, uint16_t color) {
+    if (!GFX_BoxVisible(gfx, x0 - r, y0 - r, x0 + r, y0 + r)) {
+        return;
+    }
     GFX_DrawFastVLine(gfx, display, x0, y0 - r, 2 * r + 1, color);
     GFX_FillCircleHelper(gfx, display, x0, y0, r, 3, 0, color);
 }
@@ -556,39 +1825,7 @@ void GFX_FillCircle(GFX_t *gfx, void *display, int16_t x0, int16_t y0, int16_t r
  * @param color Outline color
  */
 void GFX_DrawCircleHelper(GFX_t *gfx, void *display, int16_t x0, int16_t y0, int16_t r, uint8_t cornername, uint16_t color) {
-    int16_t f = 1 - r;
-    int16_t ddF_x = 1;
-    int16_t ddF_y = -2 * r;
-    int16_t x = 0;
-    int16_t y = r;
-
-    while (x < y) {
-        if (f >= 0) {
-            y--;
-            ddF_y += 2;
-            f += ddF_y;
-        }
-        x++;
-        ddF_x += 2;
-        f += ddF_x;
-        
-        if (cornername & 0x4) { // Bottom right
-            GFX_DrawPixel(gfx, display, x0 + x, y0 + y, color);
-            GFX_DrawPixel(gfx, display, x0 + y, y0 + x, color);
-        }
-        if (cornername & 0x2) { // Top right
-            GFX_DrawPixel(gfx, display, x0 + x, y0 - y, color);
-            GFX_DrawPixel(gfx, display, x0 + y, y0 - x, color);
-        }
-        if (cornername & 0x8) { // Bottom left
-            GFX_DrawPixel(gfx, display, x0 - y, y0 + x, color);
-            GFX_DrawPixel(gfx, display, x0 - x, y0 + y, color);
-        }
-        if (cornername & 0x1) { // Top left
-            GFX_DrawPixel(gfx, display, x0 - y, y0 - x, color);
-            GFX_DrawPixel(gfx, display, x0 - x, y0 - y, color);
-        }
-    }
+    GFX_CircleRuns(gfx, display, x0, x0, y0, y0, r, cornername, false, color);
 }
 
 /**
@@ -640,6 +1877,484 @@ void GFX_FillCircleHelper(GFX_t *gfx, void *display, int16_t x0, int16_t y0, int
     }
 }
 
+//==============================================================================
+// ELLIPSE AND ARC FUNCTIONS
+//==============================================================================
+
+/**
+ * @brief Walk along one quadrant of an ellipse
+ */
+typedef struct {
+    int16_t x;      ///< X offset of the current pixel
+    int16_t y;      ///< Y offset of the current pixel
+    int16_t ry;     ///< Vertical radius, where the walk ends
+    int32_t err;    ///< Error term of the next diagonal step
+    int32_t rx2;    ///< Horizontal radius squared
+    int32_t ry2;    ///< Vertical radius squared
+} GFX_Ellipse_t;
+
+/**
+ * @brief Arc sector bounded by two rays from the centre
+ * 
+ * Ray directions are unit vectors scaled by GFX_ARC_ONE.
+ */
+typedef struct {
+    int16_t sx;     ///< Start ray X direction
+    int16_t sy;     ///< Start ray Y direction
+    int16_t ex;     ///< End ray X direction
+    int16_t ey;     ///< End ray Y direction
+    int16_t sweep;  ///< Clockwise extent in degrees, 360 for a full ring
+    bool hub;       ///< Whether the centre pixel belongs to the sector
+} GFX_Sector_t;
+
+/**
+ * @brief Initialise a walk along one quadrant of an ellipse
+ * 
+ * Zingl's integer ellipse algorithm: the walk starts at (rx, 0) and ends
+ * at (0, ry), moving X, Y or both on each step so the outline stays
+ * 8-connected. Both offsets are magnitudes; the caller mirrors them.
+ * 
+ * @param e Walk state
+ * @param rx Horizontal radius
+ * @param ry Vertical radius
+ */
+static void GFX_EllipseInit(GFX_Ellipse_t *e, int16_t rx, int16_t ry) {
+    e->x = rx;
+    e->y = 0;
+    e->ry = ry;
+    e->rx2 = (int32_t)rx * rx;
+    e->ry2 = (int32_t)ry * ry;
+    e->err = e->ry2 - (int32_t)rx * (2 * e->ry2 - rx);
+}
+
+/**
+ * @brief Advance an ellipse walk by one pixel
+ * 
+ * Once the walk reaches the vertical axis it climbs straight to the tip,
+ * which flat ellipses would otherwise stop short of.
+ * 
+ * @param e Walk state
+ * @return false when the walk has already reached (0, ry)
+ */
+static bool GFX_EllipseStep(GFX_Ellipse_t *e) {
+    int32_t e2;
+    
+    if (e->x == 0) {
+        if (e->y >= e->ry) {
+            return false;
+        }
+        e->y++;
+        return true;
+    }
+    e2 = 2 * e->err;
+    if (e2 >= (1 - 2 * (int32_t)e->x) * e->ry2) {
+        e->x--;
+        e->err += (1 - 2 * (int32_t)e->x) * e->ry2;
+    }
+    if (e2 <= (2 * (int32_t)e->y + 1) * e->rx2) {
+        e->y++;
+        e->err += (2 * (int32_t)e->y + 1) * e->rx2;
+    }
+    return true;
+}
+
+/**
+ * @brief Draw one run of an ellipse outline in all four quadrants
+ * 
+ * The run covers offsets [xa, xb] x [ya, yb] and is either one row or one
+ * column. Runs touching an axis are joined with their mirror image.
+ * 
+ * @param gfx Pointer to graphics context
+ * @param display Pointer to display driver instance
+ * @param x0 X coordinate of center
+ * @param y0 Y coordinate of center
+ * @param xa Smallest X offset of the run
+ * @param xb Largest X offset of the run
+ * @param ya Smallest Y offset of the run
+ * @param yb Largest Y offset of the run
+ * @param color Outline color
+ */
+static void GFX_EllipseRun(GFX_t *gfx, void *display, int16_t x0, int16_t y0,
+                           int16_t xa, int16_t xb, int16_t ya, int16_t yb, uint16_t color) {
+    if (ya != yb) {
+        if (ya == 0) {
+            GFX_WriteRun(gfx, display, x0 + xa, y0 - yb, 2 * yb + 1, true, color);
+            if (xa != 0) {
+                GFX_WriteRun(gfx, display, x0 - xa, y0 - yb, 2 * yb + 1, true, color);
+            }
+            return;
+        }
+        GFX_WriteRun(gfx, display, x0 + xa, y0 + ya, yb - ya + 1, true, color);
+        GFX_WriteRun(gfx, display, x0 + xa, y0 - yb, yb - ya + 1, true, color);
+        if (xa != 0) {
+            GFX_WriteRun(gfx, display, x0 - xa, y0 + ya, yb - ya + 1, true, color);
+            GFX_WriteRun(gfx, display, x0 - xa, y0 - yb, yb - ya + 1, true, color);
+        }
+        return;
+    }
+    
+    if (xa == 0) {
+        GFX_WriteRun(gfx, display, x0 - xb, y0 - ya, 2 * xb + 1, false, color);
+        if (ya != 0) {
+            GFX_WriteRun(gfx, display, x0 - xb, y0 + ya, 2 * xb + 1, false, color);
+        }
+        return;
+    }
+    GFX_WriteRun(gfx, display, x0 + xa, y0 - ya, xb - xa + 1, false, color);
+    GFX_WriteRun(gfx, display, x0 - xb, y0 - ya, xb - xa + 1, false, color);
+    if (ya != 0) {
+        GFX_WriteRun(gfx, display, x0 + xa, y0 + ya, xb - xa + 1, false, color);
+        GFX_WriteRun(gfx, display, x0 - xb, y0 + ya, xb - xa + 1, false, color);
+    }
+}
+
+/**
+ * @brief Draw an ellipse outline
+ * 
+ * Walks one quadrant with an integer midpoint-style error term and
+ * collects consecutive pixels that share a row or a column into runs,
+ * which are mirrored into the other quadrants as spans.
+ * 
+ * @param gfx Pointer to graphics context
+ * @param display Pointer to display driver instance
+ * @param x0 X coordinate of center
+ * @param y0 Y coordinate of center
+ * @param rx Horizontal radius
+ * @param ry Vertical radius
+ * @param color Outline color
+ */
+void GFX_DrawEllipse(GFX_t *gfx, void *display, int16_t x0, int16_t y0, int16_t rx, int16_t ry, uint16_t color) {
+    GFX_Ellipse_t e;
+    int16_t sx, sy;     // First pixel of the current run
+    int16_t px, py;     // Last pixel of the current run
+    uint8_t dir = 0;    // Run direction: 0 single pixel, 1 row, 2 column
+    uint8_t step;
+    bool more;
+    
+    if ((rx < 0) || (ry < 0) || !GFX_BoxVisible(gfx, x0 - rx, y0 - ry, x0 + rx, y0 + ry)) {
+        return;
+    }
+    
+    GFX_EllipseInit(&e, rx, ry);
+    sx = e.x;
+    sy = e.y;
+    do {
+        px = e.x;
+        py = e.y;
+        more = GFX_EllipseStep(&e);
+        step = more ? (uint8_t)((e.x != px) | ((e.y != py) << 1)) : 0;
+        
+        if ((step == 1 || step == 2) && (dir == 0 || dir == step)) {
+            dir = step;
+        } else {
+            GFX_EllipseRun(gfx, display, x0, y0, px, sx, sy, py, color);
+            sx = e.x;
+            sy = e.y;
+            dir = 0;
+        }
+    } while (more);
+}
+
+/**
+ * @brief Fill an ellipse with specified color
+ * 
+ * The first pixel the walk reaches on each row is its widest, so every
+ * row is drawn exactly once as a single span.
+ * 
+ * @param gfx Pointer to graphics context
+ * @param display Pointer to display driver instance
+ * @param x0 X coordinate of center
+ * @param y0 Y coordinate of center
+ * @param rx Horizontal radius
+ * @param ry Vertical radius
+ * @param color Fill color
+ */
+void GFX_FillEllipse(GFX_t *gfx, void *display, int16_t x0, int16_t y0, int16_t rx, int16_t ry, uint16_t color) {
+    GFX_Ellipse_t e;
+    int16_t py = 0;     // Last row drawn
+    
+    if ((rx < 0) || (ry < 0) || !GFX_BoxVisible(gfx, x0 - rx, y0 - ry, x0 + rx, y0 + ry)) {
+        return;
+    }
+    
+    GFX_EllipseInit(&e, rx, ry);
+    GFX_DrawFastHLine(gfx, display, x0 - rx, y0, 2 * rx + 1, color);
+    while (GFX_EllipseStep(&e)) {
+        if (e.y != py) {
+            py = e.y;
+            GFX_DrawFastHLine(gfx, display, x0 - e.x, y0 - e.y, 2 * e.x + 1, color);
+            GFX_DrawFastHLine(gfx, display, x0 - e.x, y0 + e.y, 2 * e.x + 1, color);
+        }
+    }
+}
+
+/**
+ * @brief Approximate the sine of an angle in degrees
+ * 
+ * Bhaskara I's rational approximation. Its error, under 0.2% of full
+ * scale, stays well below a pixel at display radii, and it needs neither
+ * math.h nor a table.
+ * 
+ * @param deg Angle in degrees (any value)
+ * @return sin(deg) scaled by GFX_ARC_ONE
+ */
+static int16_t GFX_SinDeg(int16_t deg) {
+    int32_t p;
+    bool neg = false;
+    
+    deg %= 360;
+    if (deg < 0) {
+        deg += 360;
+    }
+    if (deg >= 180) {
+        deg -= 180;
+        neg = true;
+    }
+    p = (int32_t)deg * (180 - deg);
+    p = (4 * p * GFX_ARC_ONE) / (40500 - p);
+    return neg ? (int16_t)-p : (int16_t)p;
+}
+
+/**
+ * @brief Set up the boundary rays of an arc sector
+ * 
+ * Angles are in degrees clockwise from 12 o'clock. The sector runs
+ * clockwise from start to end and is half-open: pixels on the start ray
+ * belong to it, pixels on the end ray do not, so adjacent sectors tile
+ * without overlap. A span of 360 degrees or more selects the whole ring.
+ * 
+ * @param sec Sector to initialise
+ * @param start Start angle
+ * @param end End angle
+ * @return false if the sector is empty
+ */
+static bool GFX_SectorInit(GFX_Sector_t *sec, int16_t start, int16_t end) {
+    int16_t sweep = end - start;
+    
+    if (sweep >= 360) {
+        sec->sweep = 360;
+        return true;
+    }
+    sweep %= 360;
+    if (sweep < 0) {
+        sweep += 360;
+    }
+    if (sweep == 0) {
+        return false;
+    }
+    sec->sweep = sweep;
+    
+    // Screen Y grows downwards, so the direction of angle a is (sin a, -cos a)
+    sec->sx = GFX_SinDeg(start);
+    sec->sy = -GFX_SinDeg(start + 90);
+    sec->ex = GFX_SinDeg(end);
+    sec->ey = -GFX_SinDeg(end + 90);
+    
+    // The centre pixel has no angle; it goes with the sector holding 12 o'clock
+    start %= 360;
+    if (start > 0) {
+        start -= 360;
+    }
+    sec->hub = (start + sweep > 0);
+    return true;
+}
+
+/**
+ * @brief Draw the part of one row segment that lies inside a sector
+ * 
+ * A pixel is in the half-plane of a ray when it is clockwise of the ray
+ * by less than 180 degrees (cross product positive, or zero and on the
+ * ray itself). A sector of up to 180 degrees is the start half-plane
+ * minus the end half-plane; a wider one is their union with the end
+ * half-plane's complement. The cross and dot products change by a
+ * constant per pixel, so the test costs four additions per pixel and
+ * the pixels inside are drawn as spans. The centre pixel, where both
+ * products vanish, is settled once per sector.
+ * 
+ * @param gfx Pointer to graphics context
+ * @param display Pointer to display driver instance
+ * @param sec Sector
+ * @param x0 X coordinate of center
+ * @param y0 Y coordinate of center
+ * @param xa First X offset of the segment
+ * @param xb Last X offset of the segment
+ * @param y Y offset of the row
+ * @param color Fill color
+ */
+static void GFX_ArcSpan(GFX_t *gfx, void *display, const GFX_Sector_t *sec, int16_t x0, int16_t y0,
+                        int16_t xa, int16_t xb, int16_t y, uint16_t color) {
+    int32_t cs, ds, ce, de;
+    int16_t x, run = 0;
+    bool in, hs, he, was = false;
+    
+    // Only scan the visible part of the segment
+    if (xa < gfx->clip.x0 - x0) {
+        xa = gfx->clip.x0 - x0;
+    }
+    if (xb > gfx->clip.x1 - x0) {
+        xb = gfx->clip.x1 - x0;
+    }
+    if (xa > xb) {
+        return;
+    }
+    if (sec->sweep >= 360) {
+        GFX_DrawFastHLine(gfx, display, x0 + xa, y0 + y, xb - xa + 1, color);
+        return;
+    }
+    
+    cs = (int32_t)sec->sx * y - (int32_t)sec->sy * xa;
+    ds = (int32_t)sec->sx * xa + (int32_t)sec->sy * y;
+    ce = (int32_t)sec->ex * y - (int32_t)sec->ey * xa;
+    de = (int32_t)sec->ex * xa + (int32_t)sec->ey * y;
+    for (x = xa; ; x++) {
+        hs = (cs > 0) || ((cs == 0) && (ds > 0));
+        he = (ce > 0) || ((ce == 0) && (de > 0));
+        if ((cs == 0) && (ds == 0)) {
+            in = sec->hub;
+        } else {
+            in = (sec->sweep > 180) ? (hs || !he) : (hs && !he);
+        }
+        if (in != was) {
+            if (in) {
+                run = x;
+            } else {
+                GFX_DrawFastHLine(gfx, display, x0 + run, y0 + y, x - run, color);
+            }
+            was = in;
+        }
+        if (x == xb) {
+            break;
+        }
+        cs -= sec->sy;
+        ds += sec->sx;
+        ce -= sec->ey;
+        de += sec->ex;
+    }
+    if (was) {
+        GFX_DrawFastHLine(gfx, display, x0 + run, y0 + y, xb - run + 1, color);
+    }
+}
+
+/**
+ * @brief Draw one row of a ring sector
+ * @param gfx Pointer to graphics context
+ * @param display Pointer to display driver instance
+ * @param sec Sector
+ * @param x0 X coordinate of center
+ * @param y0 Y coordinate of center
+ * @param xo Outer half-width of the row
+ * @param xi Inner (hole) half-width of the row, negative if none
+ * @param y Y offset of the row
+ * @param color Fill color
+ */
+static void GFX_ArcRow(GFX_t *gfx, void *display, const GFX_Sector_t *sec, int16_t x0, int16_t y0,
+                       int16_t xo, int16_t xi, int16_t y, uint16_t color) {
+    if ((y0 + y < gfx->clip.y0) || (y0 + y > gfx->clip.y1)) {
+        return;
+    }
+    if (xi < 0) {
+        GFX_ArcSpan(gfx, display, sec, x0, y0, -xo, xo, y, color);
+    } else {
+        GFX_ArcSpan(gfx, display, sec, x0, y0, -xo, -xi - 1, y, color);
+        GFX_ArcSpan(gfx, display, sec, x0, y0, xi + 1, xo, y, color);
+    }
+}
+
+/**
+ * @brief Fill a sector of a ring
+ * 
+ * The ring holds the pixels whose centres lie within half a pixel of the
+ * radii r - thickness + 1 to r. Its row widths are tracked incrementally
+ * from the centre outwards and each row is clipped to the sector.
+ * 
+ * @param gfx Pointer to graphics context
+ * @param display Pointer to display driver instance
+ * @param x0 X coordinate of center
+ * @param y0 Y coordinate of center
+ * @param r Outer radius
+ * @param thickness Ring thickness in pixels (r + 1 or more fills a pie)
+ * @param start Start angle, degrees clockwise from 12 o'clock
+ * @param end End angle, degrees clockwise from 12 o'clock (exclusive)
+ * @param color Fill color
+ */
+void GFX_FillArc(GFX_t *gfx, void *display, int16_t x0, int16_t y0, int16_t r, int16_t thickness,
+                 int16_t start, int16_t end, uint16_t color) {
+    GFX_Sector_t sec;
+    int16_t ri = r - thickness;             // Largest radius inside the hole
+    int32_t ro2 = (int32_t)r * r + r;       // Outer bound on x^2 + y^2
+    int32_t ri2 = (int32_t)ri * ri + ri;    // Hole bound on x^2 + y^2
+    int32_t y2;
+    int16_t xo = r;
+    int16_t xi = ri;
+    int16_t y;
+    
+    if ((r < 0) || (thickness <= 0) || !GFX_BoxVisible(gfx, x0 - r, y0 - r, x0 + r, y0 + r)) {
+        return;
+    }
+    if (!GFX_SectorInit(&sec, start, end)) {
+        return;
+    }
+    
+    for (y = 0; y <= r; y++) {
+        y2 = (int32_t)y * y;
+        while ((int32_t)xo * xo + y2 > ro2) {
+            xo--;
+        }
+        while ((xi >= 0) && ((int32_t)xi * xi + y2 > ri2)) {
+            xi--;
+        }
+        GFX_ArcRow(gfx, display, &sec, x0, y0, xo, xi, -y, color);
+        if (y != 0) {
+            GFX_ArcRow(gfx, display, &sec, x0, y0, xo, xi, y, color);
+        }
+    }
+}
+
+/**
+ * @brief Draw a one-pixel circular arc
+ * 
+ * @param gfx Pointer to graphics context
+ * @param display Pointer to display driver instance
+ * @param x0 X coordinate of center
+ * @param y0 Y coordinate of center
+ * @param r Radius
+ * @param start Start angle, degrees clockwise from 12 o'clock
+ * @param end End angle, degrees clockwise from 12 o'clock (exclusive)
+ * @param color Arc color
+ */
+void GFX_DrawArc(GFX_t *gfx, void *display, int16_t x0, int16_t y0, int16_t r,
+                 int16_t start, int16_t end, uint16_t color) {
+    GFX_FillArc(gfx, display, x0, y0, r, 1, start, end, color);
+}
+
+/**
+ * @brief Move the end of a ring gauge from one angle to another
+ * 
+ * Only the sector between the two angles is drawn: in color when the
+ * gauge grows, in bgcolor when it shrinks. Sectors are half-open, so the
+ * pixels on the boundary rays stay with the part of the gauge they
+ * belong to.
+ * 
+ * @param gfx Pointer to graphics context
+ * @param display Pointer to display driver instance
+ * @param x0 X coordinate of center
+ * @param y0 Y coordinate of center
+ * @param r Outer radius
+ * @param thickness Ring thickness in pixels
+ * @param from Previous end angle of the gauge
+ * @param to New end angle of the gauge
+ * @param color Gauge color
+ * @param bgcolor Background color
+ */
+void GFX_UpdateArc(GFX_t *gfx, void *display, int16_t x0, int16_t y0, int16_t r, int16_t thickness,
+                   int16_t from, int16_t to, uint16_t color, uint16_t bgcolor) {
+    if (to > from) {
+        GFX_FillArc(gfx, display, x0, y0, r, thickness, from, to, color);
+    } else if (to < from) {
+        GFX_FillArc(gfx, display, x0, y0, r, thickness, to, from, bgcolor);
+    }
+}
+
 //==============================================================================
 // ROUNDED RECTANGLE FUNCTIONS
 //==============================================================================
@@ -648,6 +2363,8 @@ void GFX_FillCircleHelper(GFX_t *gfx, void *display, int16_t x0, int16_t y0, int
  * @brief Draw rounded rectangle outline
  * 
  * Combines straight lines and quarter-circle arcs for rounded corners.
+ * The edges are merged with the outermost run of each corner, and all four
+ * corners come from a single midpoint pass.
  * 
  * @param gfx Pointer to graphics context
  * @param display Pointer to display driver instance
@@ -660,19 +2377,14 @@ void GFX_FillCircleHelper(GFX_t *gfx, void *display, int16_t x0, int16_t y0, int
  */
 void GFX_DrawRoundRect(GFX_t *gfx, void *display, int16_t x, int16_t y, int16_t w, int16_t h, int16_t r, uint16_t color) {
     int16_t max_radius = ((w < h) ? w : h) / 2;
-    if (r > max_radius) r = max_radius;
     
-    // Draw straight edges
-    GFX_DrawFastHLine(gfx, display, x + r, y, w - 2 * r, color);         // Top
-    GFX_DrawFastHLine(gfx, display, x + r, y + h - 1, w - 2 * r, color); // Bottom
-    GFX_DrawFastVLine(gfx, display, x, y + r, h - 2 * r, color);         // Left
-    GFX_DrawFastVLine(gfx, display, x + w - 1, y + r, h - 2 * r, color); // Right
+    if (!GFX_BoxVisible(gfx, x, y, x + w - 1, y + h - 1)) {
+        return;
+    }
+    if (r > max_radius) r = max_radius;
     
-    // Draw four corner arcs
-    GFX_DrawCircleHelper(gfx, display, x + r, y + r, r, 1, color);                   // Top-left
-    GFX_DrawCircleHelper(gfx, display, x + w - r - 1, y + r, r, 2, color);          // Top-right
-    GFX_DrawCircleHelper(gfx, display, x + w - r - 1, y + h - r - 1, r, 4, color);  // Bottom-right
-    GFX_DrawCircleHelper(gfx, display, x + r, y + h - r - 1, r, 8, color);          // Bottom-left
+    // Straight edges and all four corner arcs in one pass
+    GFX_CircleRuns(gfx, display, x + r, x + w - r - 1, y + r, y + h - r - 1, r, 0xF, true, color);
 }
 
 /**
@@ -691,6 +2403,10 @@ void GFX_DrawRoundRect(GFX_t *gfx, void *display, int16_t x, int16_t y, int16_t
  */
 void GFX_FillRoundRect(GFX_t *gfx, void *display, int16_t x, int16_t y, int16_t w, int16_t h, int16_t r, uint16_t color) {
     int16_t max_radius = ((w < h) ? w : h) / 2;
+    
+    if (!GFX_BoxVisible(gfx, x, y, x + w - 1, y + h - 1)) {
+        return;
+    }
     if (r > max_radius) r = max_radius;
 
     // Fill center rectangle
@@ -701,10 +2417,345 @@ void GFX_FillRoundRect(GFX_t *gfx, void *display, int16_t x, int16_t y, int16_t
     GFX_FillCircleHelper(gfx, display, x + r, y + r, r, 2, h - 2 * r - 1, color);
 }
 
+//==============================================================================
+// GRADIENT FUNCTIONS
+//==============================================================================
+
+/**
+ * @brief RGB565 color split into channels for interpolation
+ * 
+ * Each channel holds its 5- or 6-bit level above a 10-bit fraction. Steps
+ * between colors use the same type and are added modulo 2^16, so a
+ * negative step is stored as its two's complement.
+ */
+typedef struct {
+    uint16_t r;     ///< Red level, 6.10 fixed point
+    uint16_t g;     ///< Green level, 6.10 fixed point
+    uint16_t b;     ///< Blue level, 6.10 fixed point
+} GFX_Shade_t;
+
+/**
+ * @brief Position in a radial gradient, stepped one pixel at a time
+ */
+typedef struct {
+    int32_t dist2;  ///< Squared distance from the centre
+    int32_t hi;     ///< d^2 + d: the rounded distance grows above this
+    int32_t lo;     ///< d^2 - d: the rounded distance shrinks at or below this
+    int16_t d;      ///< Distance rounded to the nearest pixel
+    int16_t dx;     ///< X offset from the centre
+    GFX_Shade_t c;  ///< Color at distance d (held once d passes the radius)
+} GFX_Radial_t;
+
+/**
+ * @brief Ordered dither thresholds
+ * 
+ * Scaled by GFX_BAYER_THRESHOLD for the gradients, so they average to
+ * one half of a level.
+ */
+const uint8_t GFX_Bayer[4][4] = {
+    {  0,  8,  2, 10 },
+    { 12,  4, 14,  6 },
+    {  3, 11,  1,  9 },
+    { 15,  7, 13,  5 }
+};
+
+/**
+ * @brief Split an RGB565 color into fixed-point channels
+ * @param s Channels to set
+ * @param color Color to split
+ */
+static void GFX_ShadeInit(GFX_Shade_t *s, uint16_t color) {
+    s->r = (color >> 11) << 10;
+    s->g = ((color >> 5) & 0x3F) << 10;
+    s->b = (color & 0x1F) << 10;
+}
+
+/**
+ * @brief Per-step change of each channel between two colors
+ * 
+ * Rounded towards zero, so n steps never overshoot the end color.
+ * 
+ * @param s Channel steps to set
+ * @param c0 Start color
+ * @param c1 End color
+ * @param n Number of steps (> 0)
+ */
+static void GFX_ShadeStep(GFX_Shade_t *s, uint16_t c0, uint16_t c1, int16_t n) {
+    GFX_Shade_t a, b;
+    
+    GFX_ShadeInit(&a, c0);
+    GFX_ShadeInit(&b, c1);
+    s->r = (uint16_t)(((int32_t)b.r - a.r) / n);
+    s->g = (uint16_t)(((int32_t)b.g - a.g) / n);
+    s->b = (uint16_t)(((int32_t)b.b - a.b) / n);
+}
+
+/**
+ * @brief Round fixed-point channels to an RGB565 color
+ * @param s Channels
+ * @param t Rounding threshold in 1/256 of a level (128 rounds to nearest)
+ * @return Packed color
+ */
+static uint16_t GFX_ShadePack(const GFX_Shade_t *s, uint8_t t) {
+    uint16_t f = (uint16_t)t << 2;
+    
+    return (uint16_t)((((s->r + f) >> 10) << 11) | (((s->g + f) >> 10) << 5) | ((s->b + f) >> 10));
+}
+
+/**
+ * @brief Send one row of gradient pixels from the row buffer
+ * 
+ * With window support the address window is already open and the row is
+ * simply streamed on; otherwise it is drawn pixel by pixel.
+ * 
+ * @param gfx Pointer to graphics context
+ * @param display Pointer to display driver instance
+ * @param x X coordinate of the first pixel
+ * @param y Row
+ * @param len Number of pixels
+ */
+static void GFX_GradientFlush(GFX_t *gfx, void *display, int16_t x, int16_t y, int16_t len) {
+    if (GFX_HAS(gfx, setAddrWindow) && GFX_HAS(gfx, writePixels)) {
+        GFX_CALL(gfx, writePixels)(display, row_buffer, (uint16_t)len);
+        return;
+    }
+    if (!GFX_HAS(gfx, drawPixel)) {
+        return;
+    }
+    for (int16_t i = 0; i < len; i++) {
+        GFX_CALL(gfx, drawPixel)(display, x + i, y, row_buffer[i]);
+    }
+}
+
+/**
+ * @brief Fill a rectangle with a linear gradient
+ * 
+ * The visible part is sent through one address window. Each channel is
+ * kept in fixed point and stepped by addition along the row and
+ * down the rectangle, so the pixel loop has no multiply or divide; with
+ * dither set the fraction is rounded against a 4x4 Bayer threshold
+ * instead of one half, which hides the banding of the 5- and 6-bit
+ * channels.
+ * 
+ * @param gfx Pointer to graphics context
+ * @param display Pointer to display driver instance
+ * @param x X coordinate of top-left corner
+ * @param y Y coordinate of top-left corner
+ * @param w Rectangle width
+ * @param h Rectangle height
+ * @param c0 Color at the top-left
+ * @param c1 Color at the far edge or corner
+ * @param dir GFX_GRADIENT_HORIZONTAL, GFX_GRADIENT_VERTICAL or GFX_GRADIENT_DIAGONAL
+ * @param dither true to apply ordered dithering
+ */
+void GFX_FillGradientRect(GFX_t *gfx, void *display, int16_t x, int16_t y, int16_t w, int16_t h,
+                          uint16_t c0, uint16_t c1, uint8_t dir, bool dither) {
+    GFX_Shade_t row, px, sx, sy;
+    int16_t cx = x, cy = y, cw = w, ch = h;
+    int16_t n, i, j, k;
+    
+    if (!GFX_ClipRect(gfx, &cx, &cy, &cw, &ch)) {
+        return;
+    }
+    
+    // Steps across and down, over the whole (unclipped) rectangle
+    n = (dir == GFX_GRADIENT_HORIZONTAL) ? w - 1 : (dir == GFX_GRADIENT_VERTICAL) ? h - 1 : w + h - 2;
+    if (n < 1) {
+        n = 1;
+    }
+    GFX_ShadeStep(&sx, c0, c1, n);
+    sy = sx;
+    if (dir == GFX_GRADIENT_HORIZONTAL) {
+        sy.r = sy.g = sy.b = 0;
+    } else if (dir == GFX_GRADIENT_VERTICAL) {
+        sx.r = sx.g = sx.b = 0;
+    }
+    
+    // Start at the first visible pixel
+    GFX_ShadeInit(&row, c0);
+    row.r += (uint16_t)((uint32_t)(cx - x) * sx.r + (uint32_t)(cy - y) * sy.r);
+    row.g += (uint16_t)((uint32_t)(cx - x) * sx.g + (uint32_t)(cy - y) * sy.g);
+    row.b += (uint16_t)((uint32_t)(cx - x) * sx.b + (uint32_t)(cy - y) * sy.b);
+    
+    if (GFX_HAS(gfx, setAddrWindow) && GFX_HAS(gfx, writePixels)) {
+        GFX_CALL(gfx, setAddrWindow)(display, cx, cy, cw, ch);
+    }
+    for (j = 0; j < ch; j++) {
+        const uint8_t *bayer = GFX_Bayer[(cy + j) & 3];
+        
+        px = row;
+        for (i = 0; i < cw; i += k) {
+            for (k = 0; (k < GFX_LINE_PIXELS) && (i + k < cw); k++) {
+                row_buffer[k] = GFX_ShadePack(&px, dither ? GFX_BAYER_THRESHOLD(bayer[(cx + i + k) & 3]) : 128);
+                px.r += sx.r;
+                px.g += sx.g;
+                px.b += sx.b;
+            }
+            GFX_GradientFlush(gfx, display, cx + i, cy + j, k);
+        }
+        row.r += sy.r;
+        row.g += sy.g;
+        row.b += sy.b;
+    }
+}
+
+/**
+ * @brief Move a radial gradient position to its new squared distance
+ * 
+ * The rounded distance d changes by at most one per pixel step, so it is
+ * tracked against the bounds d^2 - d and d^2 + d, which are themselves
+ * updated by addition. The color follows d up to the radius.
+ * 
+ * @param p Position, with dist2 already updated
+ * @param step Channel change per pixel of distance
+ * @param r Radius beyond which the color stays constant
+ */
+static void GFX_RadialTrack(GFX_Radial_t *p, const GFX_Shade_t *step, int16_t r) {
+    while (p->dist2 > p->hi) {
+        if (p->d < r) {
+            p->c.r += step->r;
+            p->c.g += step->g;
+            p->c.b += step->b;
+        }
+        p->d++;
+        p->lo = p->hi;
+        p->hi += 2 * p->d;
+    }
+    while ((p->d > 0) && (p->dist2 <= p->lo)) {
+        p->d--;
+        p->hi = p->lo;
+        p->lo -= 2 * p->d;
+        if (p->d < r) {
+            p->c.r -= step->r;
+            p->c.g -= step->g;
+            p->c.b -= step->b;
+        }
+    }
+}
+
+/**
+ * @brief Fill a rectangle with a radial gradient
+ * 
+ * The color runs from c0 at the centre to c1 at radius r and stays c1
+ * beyond it. The squared distance is stepped by addition across each
+ * row and down the rectangle, and the rounded distance and color follow
+ * it incrementally (see GFX_RadialTrack), so only the first visible pixel
+ * needs a square root and the pixel loop has no multiply or divide.
+ * Output and dithering are as for GFX_FillGradientRect.
+ * 
+ * @param gfx Pointer to graphics context
+ * @param display Pointer to display driver instance
+ * @param x X coordinate of top-left corner
+ * @param y Y coordinate of top-left corner
+ * @param w Rectangle width
+ * @param h Rectangle height
+ * @param x0 X coordinate of the gradient centre
+ * @param y0 Y coordinate of the gradient centre
+ * @param r Gradient radius
+ * @param c0 Color at the centre
+ * @param c1 Color at radius r and beyond
+ * @param dither true to apply ordered dithering
+ */
+void GFX_FillRadialGradient(GFX_t *gfx, void *display, int16_t x, int16_t y, int16_t w, int16_t h,
+                            int16_t x0, int16_t y0, int16_t r, uint16_t c0, uint16_t c1, bool dither) {
+    GFX_Radial_t row, px;
+    GFX_Shade_t step;
+    int16_t cx = x, cy = y, cw = w, ch = h;
+    int16_t dy, i, j, k;
+    
+    if (r < 1) {
+        GFX_FillRect(gfx, display, x, y, w, h, c1);
+        return;
+    }
+    if (!GFX_ClipRect(gfx, &cx, &cy, &cw, &ch)) {
+        return;
+    }
+    
+    GFX_ShadeStep(&step, c0, c1, r);
+    
+    // Rounded distance and color of the first visible pixel
+    row.dx = cx - x0;
+    dy = cy - y0;
+    row.dist2 = (int32_t)row.dx * row.dx + (int32_t)dy * dy;
+    row.d = (int16_t)GFX_ISqrt((uint32_t)row.dist2);
+    if (row.dist2 > (int32_t)row.d * row.d + row.d) {
+        row.d++;
+    }
+    row.hi = (int32_t)row.d * row.d + row.d;
+    row.lo = row.hi - 2 * row.d;
+    GFX_ShadeInit(&row.c, c0);
+    k = min(row.d, r);
+    row.c.r += (uint16_t)k * step.r;
+    row.c.g += (uint16_t)k * step.g;
+    row.c.b += (uint16_t)k * step.b;
+    
+    if (GFX_HAS(gfx, setAddrWindow) && GFX_HAS(gfx, writePixels)) {
+        GFX_CALL(gfx, setAddrWindow)(display, cx, cy, cw, ch);
+    }
+    for (j = 0; j < ch; j++) {
+        const uint8_t *bayer = GFX_Bayer[(cy + j) & 3];
+        
+        px = row;
+        for (i = 0; i < cw; i += k) {
+            for (k = 0; (k < GFX_LINE_PIXELS) && (i + k < cw); k++) {
+                row_buffer[k] = GFX_ShadePack(&px.c, dither ? GFX_BAYER_THRESHOLD(bayer[(cx + i + k) & 3]) : 128);
+                px.dist2 += 2 * px.dx + 1;
+                px.dx++;
+                GFX_RadialTrack(&px, &step, r);
+            }
+            GFX_GradientFlush(gfx, display, cx + i, cy + j, k);
+        }
+        row.dist2 += 2 * dy + 1;
+        dy++;
+        GFX_RadialTrack(&row, &step, r);
+    }
+}
+
 //==============================================================================
 // TEXT RENDERING FUNCTIONS
 //==============================================================================
 
+/**
+ * @brief Stream an opaque character cell through one address window
+ * 
+ * Walks the 6x8 cell (scaled) in raster order and writes each run of
+ * equal color with a single writeColor call. Runs continue across row
+ * ends, so blank rows cost nothing extra.
+ * 
+ * @param gfx Pointer to graphics context
+ * @param display Pointer to display driver instance
+ * @param x X coordinate of the cell (fully inside the clip rectangle)
+ * @param y Y coordinate of the cell (fully inside the clip rectangle)
+ * @param c Printable character to draw
+ * @param color Foreground color
+ * @param bg Background color
+ * @param size_x Horizontal scaling factor
+ * @param size_y Vertical scaling factor
+ */
+static void GFX_BlitChar(GFX_t *gfx, void *display, int16_t x, int16_t y, unsigned char c, uint16_t color, uint16_t bg, uint8_t size_x, uint8_t size_y) {
+    const uint8_t *glyph = &font[(c - ' ') * 5];
+    uint16_t run = 0;
+    bool run_fg = false;
+    
+    GFX_CALL(gfx, setAddrWindow)(display, x, y, 6 * size_x, 8 * size_y);
+    
+    for (uint8_t j = 0; j < 8; j++) {
+        for (uint8_t sy = 0; sy < size_y; sy++) {
+            for (uint8_t i = 0; i < 6; i++) {
+                // Column 5 is the spacing column
+                bool fg = (i < 5) && (glyph[i] & (1 << j));
+                if ((fg != run_fg) && run) {
+                    GFX_CALL(gfx, writeColor)(display, run_fg ? color : bg, run);
+                    run = 0;
+                }
+                run_fg = fg;
+                run += size_x;
+            }
+        }
+    }
+    GFX_CALL(gfx, writeColor)(display, run_fg ? color : bg, run);
+}
+
 /**
  * @brief Draw a single character at specified position
  * 
@@ -721,13 +2772,45 @@ void GFX_FillRoundRect(GFX_t *gfx, void *display, int16_t x, int16_t y, int16_t
  * @param size_y Vertical scaling factor
  */
 void GFX_DrawChar(GFX_t *gfx, void *display, int16_t x, int16_t y, unsigned char c, uint16_t color, uint16_t bg, uint8_t size_x, uint8_t size_y) {
-    // Check if character fits on screen
-    if ((x >= gfx->width) || (y >= gfx->height) || 
-       ((x + 6 * size_x - 1) < 0) || ((y + 8 * size_y - 1) < 0)) return;
+    // Check if any part of the character is visible
+    if (!GFX_BoxVisible(gfx, x, y, x + 6 * size_x - 1, y + 8 * size_y - 1)) return;
     
     // Handle non-printable characters
     if (c < ' ' || c > '~') c = ' ';
     
+    // Opaque cells that are not clipped are streamed through one window
+    if ((bg != color) && GFX_HAS(gfx, setAddrWindow) && GFX_HAS(gfx, writeColor) &&
+        (x >= gfx->clip.x0) && (y >= gfx->clip.y0) &&
+        (x + 6 * size_x - 1 <= gfx->clip.x1) && (y + 8 * size_y - 1 <= gfx->clip.y1)) {
+        GFX_BlitChar(gfx, display, x, y, c, color, bg, size_x, size_y);
+        return;
+    }
+    
+    // Transparent text: each column byte becomes one span per run of set bits
+    if (bg == color) {
+        for (int8_t i = 0; i < 5; i++) {
+            uint8_t line = font[(c - ' ') * 5 + i];
+            int8_t j = 0;
+            while (line) {
+                while (!(line & 0x01)) {
+                    line >>= 1;
+                    j++;
+                }
+                int8_t start = j;
+                while (line & 0x01) {
+                    line >>= 1;
+                    j++;
+                }
+                if (size_x == 1 && size_y == 1) {
+                    GFX_DrawFastVLine(gfx, display, x + i, y + start, j - start, color);
+                } else {
+                    GFX_FillRect(gfx, display, x + i * size_x, y + start * size_y, size_x, (j - start) * size_y, color);
+                }
+            }
+        }
+        return;
+    }
+    
     // Draw character bitmap
     for (int8_t i = 0; i < 5; i++) {
         uint8_t line = font[(c - ' ') * 5 + i];
@@ -792,17 +2875,88 @@ void GFX_Write(GFX_t *gfx, void *display, uint8_t c) {
     }
 }
 
+/**
+ * @brief Draw a run of opaque characters on the cursor line in one window
+ * 
+ * Takes as many characters as fit fully inside the clip rectangle and
+ * the row buffer, up to the next newline, carriage return or wrap point.
+ * Each pixel row of the text box is rasterised once and written size_y
+ * times.
+ * 
+ * @param gfx Pointer to graphics context
+ * @param display Pointer to display driver instance
+ * @param str Characters to draw
+ * @return Number of characters drawn; 0 if fewer than two fit
+ */
+static uint8_t GFX_PrintRun(GFX_t *gfx, void *display, const char *str) {
+    int16_t cw = gfx->textsize_x * 6;
+    uint8_t n = 0;
+    
+    // Same wrap rule GFX_Write applies before a character
+    if (gfx->wrap && (gfx->cursor_x + cw > gfx->width)) {
+        gfx->cursor_x = 0;
+        gfx->cursor_y += gfx->textsize_y * 8;
+    }
+    if ((gfx->cursor_x < gfx->clip.x0) || (gfx->cursor_y < gfx->clip.y0) ||
+        (gfx->cursor_y + gfx->textsize_y * 8 - 1 > gfx->clip.y1)) {
+        return 0;
+    }
+    
+    while (str[n] && (str[n] != '\n') && (str[n] != '\r') &&
+           (gfx->cursor_x + (n + 1) * cw - 1 <= gfx->clip.x1) &&
+           ((n + 1) * cw <= GFX_LINE_PIXELS)) {
+        n++;
+    }
+    if (n < 2) {
+        return 0;
+    }
+    
+    GFX_CALL(gfx, setAddrWindow)(display, gfx->cursor_x, gfx->cursor_y, n * cw, gfx->textsize_y * 8);
+    
+    for (uint8_t j = 0; j < 8; j++) {
+        uint16_t *p = row_buffer;
+        for (uint8_t k = 0; k < n; k++) {
+            unsigned char c = (unsigned char)str[k];
+            if (c < ' ' || c > '~') c = ' ';
+            const uint8_t *glyph = &font[(c - ' ') * 5];
+            for (uint8_t i = 0; i < 6; i++) {
+                uint16_t color = ((i < 5) && (glyph[i] & (1 << j))) ? gfx->textcolor : gfx->textbgcolor;
+                for (uint8_t sx = 0; sx < gfx->textsize_x; sx++) {
+                    *p++ = color;
+                }
+            }
+        }
+        for (uint8_t sy = 0; sy < gfx->textsize_y; sy++) {
+            GFX_CALL(gfx, writePixels)(display, row_buffer, n * cw);
+        }
+    }
+    
+    gfx->cursor_x += n * cw;
+    return n;
+}
+
 /**
  * @brief Print a string at current cursor position
  * 
- * Prints each character in the string sequentially.
+ * Opaque text is drawn a line at a time through GFX_PrintRun when the
+ * driver supports it; everything else goes through GFX_Write character
+ * by character. Cursor and wrapping behave the same either way.
  * 
  * @param gfx Pointer to graphics context
  * @param display Pointer to display driver instance
  * @param str Null-terminated string to print
  */
 void GFX_Print(GFX_t *gfx, void *display, const char *str) {
+    bool runs = (gfx->textbgcolor != gfx->textcolor) && GFX_HAS(gfx, setAddrWindow) && GFX_HAS(gfx, writePixels);
+    
     while (*str) {
+        if (runs && (*str != '\n') && (*str != '\r')) {
+            uint8_t n = GFX_PrintRun(gfx, display, str);
+            if (n) {
+                str += n;
+                continue;
+            }
+        }
         GFX_Write(gfx, display, *str++);
     }
 }
@@ -823,6 +2977,125 @@ void GFX_PrintAt(GFX_t *gfx, void *display, int16_t x, int16_t y, const char *st
     GFX_Print(gfx, display, str);
 }
 
+//==============================================================================
+// CONSOLE FUNCTIONS
+//==============================================================================
+
+/**
+ * @brief Initialize a scrolling text console
+ * 
+ * Takes the text color and size from the graphics context. Freed lines are
+ * cleared to the text background, or black when text is transparent.
+ * 
+ * @param gfx Pointer to graphics context
+ * @param con Pointer to console structure
+ * @param x Region left edge
+ * @param y Region top edge
+ * @param w Region width in pixels
+ * @param h Region height in pixels
+ */
+void GFX_ConsoleInit(GFX_t *gfx, GFX_Console_t *con, int16_t x, int16_t y, int16_t w, int16_t h) {
+    con->x = x;
+    con->y = y;
+    con->w = w;
+    con->h = h;
+    con->cursor_x = 0;
+    con->cursor_y = 0;
+    con->textcolor = gfx->textcolor;
+    con->textbgcolor = gfx->textbgcolor;
+    con->bgcolor = (gfx->textbgcolor != gfx->textcolor) ? gfx->textbgcolor : 0x0000;
+    con->textsize_x = gfx->textsize_x;
+    con->textsize_y = gfx->textsize_y;
+}
+
+/**
+ * @brief Clear the console region and home its cursor
+ * @param gfx Pointer to graphics context
+ * @param display Pointer to display driver instance
+ * @param con Pointer to console structure
+ */
+void GFX_ConsoleClear(GFX_t *gfx, void *display, GFX_Console_t *con) {
+    GFX_FillRect(gfx, display, con->x, con->y, con->w, con->h, con->bgcolor);
+    con->cursor_x = 0;
+    con->cursor_y = 0;
+}
+
+/**
+ * @brief Scroll the console region up by one text line
+ * 
+ * Moves the region contents with the hardware copyArea hook and clears
+ * only the freed line. Without the hook the whole region is cleared and
+ * the cursor returns to the top.
+ * 
+ * @param gfx Pointer to graphics context
+ * @param display Pointer to display driver instance
+ * @param con Pointer to console structure
+ */
+void GFX_ConsoleScroll(GFX_t *gfx, void *display, GFX_Console_t *con) {
+    int16_t lh = con->textsize_y * 8;
+    
+    if (!GFX_HAS(gfx, copyArea) || (lh >= con->h)) {
+        GFX_ConsoleClear(gfx, display, con);
+        return;
+    }
+    
+    GFX_CALL(gfx, copyArea)(display, con->x, con->y + lh, con->w, con->h - lh, con->x, con->y);
+    GFX_FillRect(gfx, display, con->x, con->y + con->h - lh, con->w, lh, con->bgcolor);
+    con->cursor_y -= lh;
+}
+
+/**
+ * @brief Write a character to the console
+ * 
+ * Wraps at the region's right edge. Scrolling is deferred until a
+ * character is drawn below the last line, so a trailing newline does not
+ * leave an empty line at the bottom.
+ * 
+ * @param gfx Pointer to graphics context
+ * @param display Pointer to display driver instance
+ * @param con Pointer to console structure
+ * @param c Character to write
+ */
+void GFX_ConsoleWrite(GFX_t *gfx, void *display, GFX_Console_t *con, uint8_t c) {
+    int16_t cw = con->textsize_x * 6;
+    int16_t lh = con->textsize_y * 8;
+    
+    if (c == '\n') {
+        con->cursor_x = 0;
+        con->cursor_y += lh;
+        return;
+    }
+    if (c == '\r') {
+        con->cursor_x = 0;
+        return;
+    }
+    
+    if (con->cursor_x + cw > con->w) {
+        con->cursor_x = 0;
+        con->cursor_y += lh;
+    }
+    while ((con->cursor_y > 0) && (con->cursor_y + lh > con->h)) {
+        GFX_ConsoleScroll(gfx, display, con);
+    }
+    
+    GFX_DrawChar(gfx, display, con->x + con->cursor_x, con->y + con->cursor_y, c,
+                 con->textcolor, con->textbgcolor, con->textsize_x, con->textsize_y);
+    con->cursor_x += cw;
+}
+
+/**
+ * @brief Print a string to the console
+ * @param gfx Pointer to graphics context
+ * @param display Pointer to display driver instance
+ * @param con Pointer to console structure
+ * @param str Null-terminated string to print
+ */
+void GFX_ConsolePrint(GFX_t *gfx, void *display, GFX_Console_t *con, const char *str) {
+    while (*str) {
+        GFX_ConsoleWrite(gfx, display, con, *str++);
+    }
+}
+
 //==============================================================================
 // BITMAP FUNCTIONS
 //==============================================================================
@@ -830,7 +3103,9 @@ void GFX_PrintAt(GFX_t *gfx, void *display, int16_t x, int16_t y, const char *st
 /**
  * @brief Draw RGB bitmap image
  * 
- * Draws bitmap data directly to display using RGB565 format.
+ * Draws bitmap data directly to display using RGB565 format. Only the part
+ * inside the clip rectangle is sent, row by row through one address window
+ * when the driver supports it.
  * 
  * @param gfx Pointer to graphics context
  * @param display Pointer to display driver instance
@@ -841,9 +3116,29 @@ void GFX_PrintAt(GFX_t *gfx, void *display, int16_t x, int16_t y, const char *st
  * @param h Bitmap height in pixels
  */
 void GFX_DrawBitmapRGB(GFX_t *gfx, void *display, int16_t x, int16_t y, const uint16_t *bitmap, int16_t w, int16_t h) {
-    for (int16_t j = 0; j < h; j++) {
-        for (int16_t i = 0; i < w; i++) {
-            gfx->drawPixel(display, x + i, y + j, bitmap[j * w + i]);
+    int16_t cx = x, cy = y, cw = w, ch = h;
+    
+    if (!GFX_ClipRect(gfx, &cx, &cy, &cw, &ch)) {
+        return;
+    }
+    
+    // Skip the clipped top rows and left columns; rows keep the source stride
+    bitmap += (int32_t)(cy - y) * w + (cx - x);
+    
+    if (GFX_HAS(gfx, setAddrWindow) && GFX_HAS(gfx, writePixels)) {
+        GFX_CALL(gfx, setAddrWindow)(display, cx, cy, cw, ch);
+        for (int16_t j = 0; j < ch; j++, bitmap += w) {
+            GFX_CALL(gfx, writePixels)(display, bitmap, cw);
+        }
+        return;
+    }
+    if (!GFX_HAS(gfx, drawPixel)) {
+        return;
+    }
+    
+    for (int16_t j = 0; j < ch; j++, bitmap += w) {
+        for (int16_t i = 0; i < cw; i++) {
+            GFX_CALL(gfx, drawPixel)(display, cx + i, cy + j, bitmap[i]);
         }
     }
 }
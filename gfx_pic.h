@@ -14,6 +14,7 @@
 
 #include <stdint.h>
 #include <stdbool.h>
+#include "gfx_config.h"
 
 //==============================================================================
 // CONSTANTS
@@ -25,6 +26,44 @@
 /** @brief Default font height in pixels */
 #define GFX_FONT_HEIGHT     8
 
+/** @brief Pixels in the row buffer shared by text runs and pixel batches */
+#define GFX_LINE_PIXELS     96
+
+/** @brief Points GFX_DrawPixels sorts at a time (entries in its index buffer) */
+#define GFX_PIXEL_BATCH     128
+
+/** @brief Clip rows the pixel batch sort has buckets for (one per panel row) */
+#define GFX_SORT_ROWS       64
+
+/** @brief Number of clip rectangles GFX_PushClip can save */
+#define GFX_CLIP_DEPTH      4
+
+/** @brief Most vertices GFX_FillPolygon accepts (one edge-table entry each) */
+#define GFX_POLY_EDGES      16
+
+/** @brief Polygon fill rule: inside where an odd number of edges lie to the left */
+#define GFX_FILL_EVEN_ODD   0
+
+/** @brief Polygon fill rule: inside where the edge winding number is not zero */
+#define GFX_FILL_NONZERO    1
+
+/** @brief Gradient direction: left to right */
+#define GFX_GRADIENT_HORIZONTAL 0
+
+/** @brief Gradient direction: top to bottom */
+#define GFX_GRADIENT_VERTICAL   1
+
+/** @brief Gradient direction: top-left to bottom-right */
+#define GFX_GRADIENT_DIAGONAL   2
+
+/**
+ * @brief 4x4 Bayer matrix, values 0-15
+ * 
+ * Shared by every ordered dither in the library; each user scales the
+ * entries to the bits it drops.
+ */
+extern const uint8_t GFX_Bayer[4][4];
+
 //==============================================================================
 // DATA STRUCTURES
 //==============================================================================
@@ -37,6 +76,16 @@ typedef struct {
     int16_t y; ///< Y coordinate
 } GFX_Point_t;
 
+/**
+ * @brief Rectangle given by its inclusive corner coordinates
+ */
+typedef struct {
+    int16_t x0; ///< Left edge
+    int16_t y0; ///< Top edge
+    int16_t x1; ///< Right edge
+    int16_t y1; ///< Bottom edge
+} GFX_Rect_t;
+
 /**
  * @brief Graphics context structure
  * 
@@ -62,6 +111,11 @@ typedef struct {
     uint8_t rotation;        ///< Display rotation (0-3: 0, 90, 180, 270)
     bool wrap;               ///< Enable/disable automatic text wrapping
     bool cp437;              ///< Enable extended CP437 character set
+    
+    // Clipping
+    GFX_Rect_t clip;                         ///< Current clip rectangle
+    GFX_Rect_t clip_stack[GFX_CLIP_DEPTH];   ///< Rectangles saved by GFX_PushClip
+    uint8_t clip_depth;                      ///< Number of saved rectangles
 
     // Hardware-specific function pointers
     void (*drawPixel)(void *display, int16_t x, int16_t y, uint16_t color);
@@ -69,9 +123,40 @@ typedef struct {
     void (*drawFastVLine)(void *display, int16_t x, int16_t y, int16_t h, uint16_t color);
     void (*drawFastHLine)(void *display, int16_t x, int16_t y, int16_t w, uint16_t color);
     void (*fillRect)(void *display, int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color);
+    void (*drawLine)(void *display, int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint16_t color);
+    void (*drawRect)(void *display, int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color);
+    void (*copyArea)(void *display, int16_t x, int16_t y, int16_t w, int16_t h, int16_t x2, int16_t y2);
     void (*writePixel)(void *display, uint16_t color);
+    void (*setAddrWindow)(void *display, int16_t x, int16_t y, int16_t w, int16_t h);
+    void (*writeColor)(void *display, uint16_t color, uint16_t count);
+    void (*writePixels)(void *display, const uint16_t *colors, uint16_t count);
 } GFX_t;
 
+/**
+ * @brief Scrolling text console
+ * 
+ * A text region with its own cursor and colors. When the cursor runs off
+ * the bottom, the region scrolls up one text line.
+ */
+typedef struct {
+    // Scroll region
+    int16_t x;               ///< Region left edge
+    int16_t y;               ///< Region top edge
+    int16_t w;               ///< Region width in pixels
+    int16_t h;               ///< Region height in pixels
+    
+    // Cursor, relative to the region
+    int16_t cursor_x;        ///< Current text cursor X position
+    int16_t cursor_y;        ///< Current text cursor Y position
+    
+    // Text settings
+    uint16_t textcolor;      ///< Text color
+    uint16_t textbgcolor;    ///< Text background color
+    uint16_t bgcolor;        ///< Color freed lines are cleared to
+    uint8_t textsize_x;      ///< Horizontal text scale
+    uint8_t textsize_y;      ///< Vertical text scale
+} GFX_Console_t;
+
 //==============================================================================
 // INITIALIZATION FUNCTIONS
 //==============================================================================
@@ -84,6 +169,76 @@ typedef struct {
  */
 void GFX_Init(GFX_t *gfx, int16_t w, int16_t h);
 
+//==============================================================================
+// CLIPPING FUNCTIONS
+//==============================================================================
+
+/**
+ * @brief Reset clipping to the whole display and empty the clip stack
+ * @param gfx Pointer to graphics context
+ */
+void GFX_ResetClip(GFX_t *gfx);
+
+/**
+ * @brief Set the clip rectangle (intersected with the display)
+ * @param gfx Pointer to graphics context
+ * @param x Left edge
+ * @param y Top edge
+ * @param w Width in pixels
+ * @param h Height in pixels
+ */
+void GFX_SetClipRect(GFX_t *gfx, int16_t x, int16_t y, int16_t w, int16_t h);
+
+/**
+ * @brief Save the clip rectangle and narrow it to its intersection with a new one
+ * @param gfx Pointer to graphics context
+ * @param x Left edge
+ * @param y Top edge
+ * @param w Width in pixels
+ * @param h Height in pixels
+ * @return false if the clip stack is full (clipping is left unchanged)
+ */
+bool GFX_PushClip(GFX_t *gfx, int16_t x, int16_t y, int16_t w, int16_t h);
+
+/**
+ * @brief Restore the clip rectangle saved by the matching GFX_PushClip
+ * @param gfx Pointer to graphics context
+ */
+void GFX_PopClip(GFX_t *gfx);
+
+/**
+ * @brief Trim a rectangle to the clip rectangle
+ * @param gfx Pointer to graphics context
+ * @param x Left edge, updated
+ * @param y Top edge, updated
+ * @param w Width, updated
+ * @param h Height, updated
+ * @return false if nothing of the rectangle is visible
+ */
+bool GFX_ClipRect(GFX_t *gfx, int16_t *x, int16_t *y, int16_t *w, int16_t *h);
+
+/**
+ * @brief Clip a line segment to the clip rectangle (Cohen-Sutherland)
+ * @param gfx Pointer to graphics context
+ * @param x0 Start X coordinate, updated
+ * @param y0 Start Y coordinate, updated
+ * @param x1 End X coordinate, updated
+ * @param y1 End Y coordinate, updated
+ * @return false if nothing of the line is visible
+ */
+bool GFX_ClipLine(GFX_t *gfx, int16_t *x0, int16_t *y0, int16_t *x1, int16_t *y1);
+
+/**
+ * @brief Test whether a bounding box touches the clip rectangle
+ * @param gfx Pointer to graphics context
+ * @param x0 Left edge
+ * @param y0 Top edge
+ * @param x1 Right edge (inclusive)
+ * @param y1 Bottom edge (inclusive)
+ * @return true if any part of the box may be visible
+ */
+bool GFX_BoxVisible(GFX_t *gfx, int16_t x0, int16_t y0, int16_t x1, int16_t y1);
+
 //==============================================================================
 // BASIC DRAWING PRIMITIVES
 //==============================================================================
@@ -98,6 +253,38 @@ void GFX_Init(GFX_t *gfx, int16_t w, int16_t h);
  */
 void GFX_DrawPixel(GFX_t *gfx, void *display, int16_t x, int16_t y, uint16_t color);
 
+/**
+ * @brief Draw a batch of pixels, merging neighbours into runs
+ * 
+ * Points are bucket-sorted by row, GFX_PIXEL_BATCH at a time, and each
+ * run of horizontally adjacent pixels is sent through one window. Where
+ * a point repeats, the later color wins. The arrays are not modified.
+ * Points more than GFX_SORT_ROWS rows below the clip top, which only
+ * happens in the portrait rotations, are drawn one at a time.
+ * 
+ * @param gfx Pointer to graphics context
+ * @param display Pointer to display driver
+ * @param pts Pixel coordinates
+ * @param colors Color of each pixel
+ * @param n Number of pixels
+ */
+void GFX_DrawPixels(GFX_t *gfx, void *display, const GFX_Point_t *pts, const uint16_t *colors, uint16_t n);
+
+/**
+ * @brief Draw a batch of pixels, sorting the caller's arrays in place
+ * 
+ * Same output as GFX_DrawPixels, but sorts up to 255 points at a time
+ * inside pts and colors instead of an index buffer. Both arrays are left
+ * reordered, and where a point repeats, which color wins is unspecified.
+ * 
+ * @param gfx Pointer to graphics context
+ * @param display Pointer to display driver
+ * @param pts Pixel coordinates (reordered)
+ * @param colors Color of each pixel (reordered with pts)
+ * @param n Number of pixels
+ */
+void GFX_DrawPixelsInPlace(GFX_t *gfx, void *display, GFX_Point_t *pts, uint16_t *colors, uint16_t n);
+
 /**
  * @brief Draw a line between two points
  * @param gfx Pointer to graphics context
@@ -110,6 +297,22 @@ void GFX_DrawPixel(GFX_t *gfx, void *display, int16_t x, int16_t y, uint16_t col
  */
 void GFX_DrawLine(GFX_t *gfx, void *display, int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint16_t color);
 
+/**
+ * @brief Draw a line pixel by pixel, bypassing the drawLine hook
+ * 
+ * No analytic clipping is done; each pixel is checked against the clip
+ * rectangle.
+ * 
+ * @param gfx Pointer to graphics context
+ * @param display Pointer to display driver
+ * @param x0 X coordinate of start point
+ * @param y0 Y coordinate of start point
+ * @param x1 X coordinate of end point
+ * @param y1 Y coordinate of end point
+ * @param color Line color
+ */
+void GFX_WriteLine(GFX_t *gfx, void *display, int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint16_t color);
+
 /**
  * @brief Draw a vertical line (optimized)
  * @param gfx Pointer to graphics context
@@ -215,6 +418,92 @@ void GFX_FillCircle(GFX_t *gfx, void *display, int16_t x0, int16_t y0, int16_t r
  */
 void GFX_FillCircleHelper(GFX_t *gfx, void *display, int16_t x0, int16_t y0, int16_t r, uint8_t cornername, int16_t delta, uint16_t color);
 
+//==============================================================================
+// ELLIPSE AND ARC FUNCTIONS
+//==============================================================================
+
+/**
+ * @brief Draw an ellipse outline
+ * @param gfx Pointer to graphics context
+ * @param display Pointer to display driver
+ * @param x0 X coordinate of center
+ * @param y0 Y coordinate of center
+ * @param rx Horizontal radius
+ * @param ry Vertical radius
+ * @param color Outline color
+ */
+void GFX_DrawEllipse(GFX_t *gfx, void *display, int16_t x0, int16_t y0, int16_t rx, int16_t ry, uint16_t color);
+
+/**
+ * @brief Fill an ellipse
+ * @param gfx Pointer to graphics context
+ * @param display Pointer to display driver
+ * @param x0 X coordinate of center
+ * @param y0 Y coordinate of center
+ * @param rx Horizontal radius
+ * @param ry Vertical radius
+ * @param color Fill color
+ */
+void GFX_FillEllipse(GFX_t *gfx, void *display, int16_t x0, int16_t y0, int16_t rx, int16_t ry, uint16_t color);
+
+/**
+ * @brief Draw a one-pixel circular arc
+ * 
+ * Angles are in degrees clockwise from 12 o'clock. The arc runs clockwise
+ * from start up to, but not including, end; a span of 360 or more draws
+ * the whole circle.
+ * 
+ * @param gfx Pointer to graphics context
+ * @param display Pointer to display driver
+ * @param x0 X coordinate of center
+ * @param y0 Y coordinate of center
+ * @param r Radius
+ * @param start Start angle in degrees
+ * @param end End angle in degrees (exclusive)
+ * @param color Arc color
+ */
+void GFX_DrawArc(GFX_t *gfx, void *display, int16_t x0, int16_t y0, int16_t r,
+                 int16_t start, int16_t end, uint16_t color);
+
+/**
+ * @brief Fill a sector of a ring
+ * 
+ * Angles as for GFX_DrawArc. The ring reaches from radius r inwards by
+ * thickness pixels; a thickness above r fills a pie slice.
+ * 
+ * @param gfx Pointer to graphics context
+ * @param display Pointer to display driver
+ * @param x0 X coordinate of center
+ * @param y0 Y coordinate of center
+ * @param r Outer radius
+ * @param thickness Ring thickness in pixels
+ * @param start Start angle in degrees
+ * @param end End angle in degrees (exclusive)
+ * @param color Fill color
+ */
+void GFX_FillArc(GFX_t *gfx, void *display, int16_t x0, int16_t y0, int16_t r, int16_t thickness,
+                 int16_t start, int16_t end, uint16_t color);
+
+/**
+ * @brief Move the end of a ring gauge, redrawing only the change
+ * 
+ * Fills the sector from the old to the new angle with color when the
+ * gauge grows, or with bgcolor when it shrinks.
+ * 
+ * @param gfx Pointer to graphics context
+ * @param display Pointer to display driver
+ * @param x0 X coordinate of center
+ * @param y0 Y coordinate of center
+ * @param r Outer radius
+ * @param thickness Ring thickness in pixels
+ * @param from Previous end angle in degrees
+ * @param to New end angle in degrees
+ * @param color Gauge color
+ * @param bgcolor Background color
+ */
+void GFX_UpdateArc(GFX_t *gfx, void *display, int16_t x0, int16_t y0, int16_t r, int16_t thickness,
+                   int16_t from, int16_t to, uint16_t color, uint16_t bgcolor);
+
 //==============================================================================
 // TRIANGLE FUNCTIONS
 //==============================================================================
@@ -247,6 +536,86 @@ void GFX_DrawTriangle(GFX_t *gfx, void *display, int16_t x0, int16_t y0, int16_t
  */
 void GFX_FillTriangle(GFX_t *gfx, void *display, int16_t x0, int16_t y0, int16_t x1, int16_t y1, int16_t x2, int16_t y2, uint16_t color);
 
+/**
+ * @brief Draw a filled triangle that tiles with its neighbours
+ * 
+ * Follows the top-left rule: pixels on a right or bottom edge are left
+ * out, so triangles sharing an edge neither overlap nor leave gaps.
+ * Triangles with no area draw nothing.
+ * 
+ * @param gfx Pointer to graphics context
+ * @param display Pointer to display driver
+ * @param x0 X coordinate of first vertex
+ * @param y0 Y coordinate of first vertex
+ * @param x1 X coordinate of second vertex
+ * @param y1 Y coordinate of second vertex
+ * @param x2 X coordinate of third vertex
+ * @param y2 Y coordinate of third vertex
+ * @param color Fill color
+ */
+void GFX_FillTriangleTopLeft(GFX_t *gfx, void *display, int16_t x0, int16_t y0, int16_t x1, int16_t y1, int16_t x2, int16_t y2, uint16_t color);
+
+//==============================================================================
+// POLYGON FUNCTIONS
+//==============================================================================
+
+/**
+ * @brief Draw a filled polygon
+ * 
+ * The polygon is closed from the last vertex back to the first and may be
+ * concave or self-intersecting. Polygons with fewer than 3 or more than
+ * GFX_POLY_EDGES vertices are ignored.
+ * 
+ * @param gfx Pointer to graphics context
+ * @param display Pointer to display driver
+ * @param points Array of vertices
+ * @param n Number of vertices
+ * @param rule GFX_FILL_EVEN_ODD or GFX_FILL_NONZERO
+ * @param color Fill color
+ */
+void GFX_FillPolygon(GFX_t *gfx, void *display, const GFX_Point_t *points, uint8_t n, uint8_t rule, uint16_t color);
+
+//==============================================================================
+// THICK AND ANTI-ALIASED LINES
+//==============================================================================
+
+/**
+ * @brief Draw a line of a given width
+ * 
+ * The line is filled as a quadrilateral with square ends at the two
+ * endpoints. A width of 1 draws an ordinary line.
+ * 
+ * @param gfx Pointer to graphics context
+ * @param display Pointer to display driver
+ * @param x0 X coordinate of start point
+ * @param y0 Y coordinate of start point
+ * @param x1 X coordinate of end point
+ * @param y1 Y coordinate of end point
+ * @param width Line width in pixels
+ * @param color Line color
+ */
+void GFX_DrawThickLine(GFX_t *gfx, void *display, int16_t x0, int16_t y0, int16_t x1, int16_t y1,
+                       int16_t width, uint16_t color);
+
+/**
+ * @brief Draw an anti-aliased line over a known background
+ * 
+ * Wu's algorithm. Edge pixels are blended with bgcolor rather than read
+ * back, so the line should be drawn over an area of that color. Each
+ * step writes both pixels beside the line, including faint ones.
+ * 
+ * @param gfx Pointer to graphics context
+ * @param display Pointer to display driver
+ * @param x0 X coordinate of start point
+ * @param y0 Y coordinate of start point
+ * @param x1 X coordinate of end point
+ * @param y1 Y coordinate of end point
+ * @param color Line color
+ * @param bgcolor Background color
+ */
+void GFX_DrawLineAA(GFX_t *gfx, void *display, int16_t x0, int16_t y0, int16_t x1, int16_t y1,
+                    uint16_t color, uint16_t bgcolor);
+
 //==============================================================================
 // ROUNDED RECTANGLE FUNCTIONS
 //==============================================================================
@@ -277,6 +646,53 @@ void GFX_DrawRoundRect(GFX_t *gfx, void *display, int16_t x, int16_t y, int16_t
  */
 void GFX_FillRoundRect(GFX_t *gfx, void *display, int16_t x, int16_t y, int16_t w, int16_t h, int16_t r, uint16_t color);
 
+//==============================================================================
+// GRADIENT FUNCTIONS
+//==============================================================================
+
+/**
+ * @brief Fill a rectangle with a linear gradient
+ * 
+ * The gradient runs from c0 at the top-left to c1 at the right edge, the
+ * bottom edge or the bottom-right corner. The pixels are streamed through
+ * one address window.
+ * 
+ * @param gfx Pointer to graphics context
+ * @param display Pointer to display driver
+ * @param x X coordinate of top-left corner
+ * @param y Y coordinate of top-left corner
+ * @param w Rectangle width
+ * @param h Rectangle height
+ * @param c0 Start color
+ * @param c1 End color
+ * @param dir GFX_GRADIENT_HORIZONTAL, GFX_GRADIENT_VERTICAL or GFX_GRADIENT_DIAGONAL
+ * @param dither true to apply ordered dithering
+ */
+void GFX_FillGradientRect(GFX_t *gfx, void *display, int16_t x, int16_t y, int16_t w, int16_t h,
+                          uint16_t c0, uint16_t c1, uint8_t dir, bool dither);
+
+/**
+ * @brief Fill a rectangle with a radial gradient
+ * 
+ * The color runs from c0 at (x0, y0) to c1 at distance r, and is c1
+ * beyond. The centre may lie outside the rectangle.
+ * 
+ * @param gfx Pointer to graphics context
+ * @param display Pointer to display driver
+ * @param x X coordinate of top-left corner
+ * @param y Y coordinate of top-left corner
+ * @param w Rectangle width
+ * @param h Rectangle height
+ * @param x0 X coordinate of the gradient centre
+ * @param y0 Y coordinate of the gradient centre
+ * @param r Gradient radius
+ * @param c0 Color at the centre
+ * @param c1 Color at radius r and beyond
+ * @param dither true to apply ordered dithering
+ */
+void GFX_FillRadialGradient(GFX_t *gfx, void *display, int16_t x, int16_t y, int16_t w, int16_t h,
+                            int16_t x0, int16_t y0, int16_t r, uint16_t c0, uint16_t c1, bool dither);
+
 //==============================================================================
 // BITMAP FUNCTIONS
 //==============================================================================
@@ -396,6 +812,59 @@ void GFX_Print(GFX_t *gfx, void *display, const char *str);
  */
 void GFX_PrintAt(GFX_t *gfx, void *display, int16_t x, int16_t y, const char *str);
 
+//==============================================================================
+// CONSOLE FUNCTIONS
+//==============================================================================
+
+/**
+ * @brief Initialize a scrolling text console
+ * 
+ * Takes the text color and size from the graphics context. Freed lines are
+ * cleared to the text background, or black when text is transparent.
+ * 
+ * @param gfx Pointer to graphics context
+ * @param con Pointer to console structure
+ * @param x Region left edge
+ * @param y Region top edge
+ * @param w Region width in pixels
+ * @param h Region height in pixels
+ */
+void GFX_ConsoleInit(GFX_t *gfx, GFX_Console_t *con, int16_t x, int16_t y, int16_t w, int16_t h);
+
+/**
+ * @brief Clear the console region and home its cursor
+ * @param gfx Pointer to graphics context
+ * @param display Pointer to display driver
+ * @param con Pointer to console structure
+ */
+void GFX_ConsoleClear(GFX_t *gfx, void *display, GFX_Console_t *con);
+
+/**
+ * @brief Scroll the console region up by one text line
+ * @param gfx Pointer to graphics context
+ * @param display Pointer to display driver
+ * @param con Pointer to console structure
+ */
+void GFX_ConsoleScroll(GFX_t *gfx, void *display, GFX_Console_t *con);
+
+/**
+ * @brief Write a character to the console
+ * @param gfx Pointer to graphics context
+ * @param display Pointer to display driver
+ * @param con Pointer to console structure
+ * @param c Character to write
+ */
+void GFX_ConsoleWrite(GFX_t *gfx, void *display, GFX_Console_t *con, uint8_t c);
+
+/**
+ * @brief Print a string to the console
+ * @param gfx Pointer to graphics context
+ * @param display Pointer to display driver
+ * @param con Pointer to console structure
+ * @param str String to print (null-terminated)
+ */
+void GFX_ConsolePrint(GFX_t *gfx, void *display, GFX_Console_t *con, const char *str);
+
 //==============================================================================
 // GETTER FUNCTIONS
 //==============================================================================
@@ -446,6 +915,15 @@ int16_t GFX_Height(GFX_t *gfx);
  */
 void GFX_Swap(int16_t *a, int16_t *b);
 
+/**
+ * @brief Blend two RGB565 colors channel by channel
+ * @param fg Foreground color
+ * @param bg Background color
+ * @param alpha Weight of fg, 0 (all bg) to 32 (all fg)
+ * @return Blended color
+ */
+uint16_t GFX_Blend565(uint16_t fg, uint16_t bg, uint8_t alpha);
+
 //==============================================================================
 // CONVENIENCE MACROS (ARDUINO STYLE)
 //==============================================================================
@@ -48,6 +48,7 @@ char buffer[20];
 // Line drawing tests
 void testlines(uint16_t color);
 void testfastlines(uint16_t color1, uint16_t color2);
+void testsmoothlines(void);
 
 // Rectangle drawing tests
 void testdrawrects(uint16_t color);
@@ -60,14 +61,35 @@ void testdrawcircles(uint8_t radius, uint16_t color);
 
 // Triangle drawing tests
 void testtriangles(void);
+void testpolygons(void);
+void testarcs(void);
+void testgradients(void);
 
 // Text and display tests
 void tftPrintTest(void);
 void lcdTestPattern(void);
+void testconsole(void);
+void testscanlines(void);
 
 // Image display tests
 void testimages(void);
 
+//==============================================================================
+// INTERRUPT HANDLER
+//==============================================================================
+
+#if defined(SSD1331_USE_DMA) || defined(SSD1331_USE_QUEUE)
+/**
+ * @brief Single-vector interrupt service routine (MVECEN = OFF)
+ *
+ * Forwards interrupts to the display driver, which uses them to advance
+ * background transfers.
+ */
+void __interrupt() INTERRUPT_InterruptManager(void) {
+    SSD1331_InterruptHandler();
+}
+#endif
+
 //==============================================================================
 // MAIN FUNCTION
 //==============================================================================
@@ -85,10 +107,16 @@ void main(void) {
     // Open SPI1 with default settings
     SPI1_Open(SPI1_DEFAULT);
 
+#if defined(SSD1331_USE_DMA) || defined(SSD1331_USE_QUEUE)
+    // Background transfers only advance from the display interrupts,
+    // including the ones SSD1331_Begin starts
+    INTCON0bits.GIE = 1;
+#endif
+
     // Initialize and start the OLED display
     SSD1331_Init(&oled);
     SSD1331_Begin(&oled);
-    
+
     // Main application loop - equivalent to Arduino loop() function
     while(1) {
         // Clear screen to start fresh
@@ -101,6 +129,10 @@ void main(void) {
         lcdTestPattern();
         __delay_ms(DELAY_MEDIUM);
 
+        // Software-rendered gradient through the scanline pipeline
+        testscanlines();
+        __delay_ms(DELAY_MEDIUM);
+
         // Text wrapping demonstration
         SSD1331_FillScreen(&oled, SSD1331_BLACK);
         GFX_SetCursor(&oled.gfx, 0, 0);
@@ -112,6 +144,10 @@ void main(void) {
         // Comprehensive text formatting test
         tftPrintTest();
         __delay_ms(DELAY_LONG);
+
+        // Hardware-scrolled log console
+        testconsole();
+        __delay_ms(DELAY_MEDIUM);
         
         // Single pixel test - draw center pixel
         SSD1331_FillScreen(&oled, SSD1331_BLACK);
@@ -147,6 +183,22 @@ void main(void) {
         // Triangle tests
         testtriangles();
         __delay_ms(DELAY_SHORT);
+        
+        // Polygon fill tests
+        testpolygons();
+        __delay_ms(DELAY_MEDIUM);
+        
+        // Ellipse and arc tests
+        testarcs();
+        __delay_ms(DELAY_MEDIUM);
+        
+        // Thick and anti-aliased line tests
+        testsmoothlines();
+        __delay_ms(DELAY_MEDIUM);
+        
+        // Gradient fill tests
+        testgradients();
+        __delay_ms(DELAY_LONG);
          
          
         
@@ -231,6 +283,24 @@ void testfastlines(uint16_t color1, uint16_t color2) {
     }
 }
 
+/**
+ * @brief Test thick and anti-aliased lines
+ * 
+ * Draws a fan of anti-aliased lines on the left and a zigzag trend line
+ * of increasing width on the right.
+ */
+void testsmoothlines(void) {
+    static const int8_t trend[] = {50, 30, 42, 12, 24, 6};
+    
+    SSD1331_FillScreen(&oled, SSD1331_BLACK);
+    for (int16_t y = 0; y < oled.gfx.height; y += 8) {
+        GFX_DrawLineAA(&oled.gfx, &oled, 0, 0, 44, y, SSD1331_WHITE, SSD1331_BLACK);
+    }
+    for (uint8_t i = 0; i < 5; i++) {
+        GFX_DrawThickLine(&oled.gfx, &oled, 48 + 9 * i, trend[i], 57 + 9 * i, trend[i + 1], i + 1, SSD1331_CYAN);
+    }
+}
+
 //==============================================================================
 // RECTANGLE DRAWING TESTS
 //==============================================================================
@@ -267,8 +337,7 @@ void testfillrects(uint16_t color1, uint16_t color2) {
     SSD1331_FillScreen(&oled, SSD1331_BLACK);
     
     for (int16_t x = oled.gfx.height - 1; x > 6; x -= 6) {
-        //GFX_FillRect(&oled.gfx, &oled, 
-        SSD1331_FillRect_Fast(&oled,
+        GFX_FillRect(&oled.gfx, &oled, 
                      (oled.gfx.width - 1) / 2 - x / 2, 
                      (oled.gfx.height - 1) / 2 - x / 2, 
                      x, x, color1);
@@ -374,6 +443,66 @@ void testtriangles(void) {
     }
 }
 
+/**
+ * @brief Test polygon filling
+ * 
+ * Fills the same self-intersecting star with the even-odd rule (hollow
+ * centre) and the nonzero rule (solid), with a concave arrow underneath.
+ */
+void testpolygons(void) {
+    static const GFX_Point_t star[] = {{22, 0}, {35, 38}, {2, 14}, {42, 14}, {9, 38}};
+    static const GFX_Point_t arrow[] = {{20, 46}, {60, 46}, {60, 40}, {76, 52}, {60, 63}, {60, 57}, {20, 57}};
+    GFX_Point_t p[5];
+    
+    SSD1331_FillScreen(&oled, SSD1331_BLACK);
+    GFX_FillPolygon(&oled.gfx, &oled, star, 5, GFX_FILL_EVEN_ODD, SSD1331_YELLOW);
+    for (uint8_t i = 0; i < 5; i++) {
+        p[i].x = star[i].x + 50;
+        p[i].y = star[i].y;
+    }
+    GFX_FillPolygon(&oled.gfx, &oled, p, 5, GFX_FILL_NONZERO, SSD1331_CYAN);
+    GFX_FillPolygon(&oled.gfx, &oled, arrow, 7, GFX_FILL_EVEN_ODD, SSD1331_GREEN);
+}
+
+/**
+ * @brief Test ellipses and ring gauges
+ * 
+ * Draws nested ellipses, then sweeps a ring gauge up and back down,
+ * redrawing only the sector that changes on each step.
+ */
+void testarcs(void) {
+    int16_t angle = -120;
+    
+    SSD1331_FillScreen(&oled, SSD1331_BLACK);
+    GFX_FillEllipse(&oled.gfx, &oled, 23, 32, 21, 14, SSD1331_BLUE);
+    GFX_DrawEllipse(&oled.gfx, &oled, 23, 32, 10, 28, SSD1331_YELLOW);
+    
+    GFX_DrawArc(&oled.gfx, &oled, 70, 32, 24, -120, 120, SSD1331_WHITE);
+    for (int16_t a = -120; a <= 120; a += 8) {
+        GFX_UpdateArc(&oled.gfx, &oled, 70, 32, 21, 6, angle, a, SSD1331_GREEN, SSD1331_BLACK);
+        angle = a;
+        __delay_ms(20);
+    }
+    for (int16_t a = 120; a >= 0; a -= 8) {
+        GFX_UpdateArc(&oled.gfx, &oled, 70, 32, 21, 6, angle, a, SSD1331_GREEN, SSD1331_BLACK);
+        angle = a;
+        __delay_ms(20);
+    }
+}
+
+/**
+ * @brief Test gradient fills
+ * 
+ * The same dark horizontal ramp plain and dithered, a diagonal ramp and
+ * a radial glow, one per quarter of the screen.
+ */
+void testgradients(void) {
+    GFX_FillGradientRect(&oled.gfx, &oled, 0, 0, 48, 32, SSD1331_BLACK, 0x0010, GFX_GRADIENT_HORIZONTAL, false);
+    GFX_FillGradientRect(&oled.gfx, &oled, 0, 32, 48, 32, SSD1331_BLACK, 0x0010, GFX_GRADIENT_HORIZONTAL, true);
+    GFX_FillGradientRect(&oled.gfx, &oled, 48, 0, 48, 32, SSD1331_RED, SSD1331_YELLOW, GFX_GRADIENT_DIAGONAL, true);
+    GFX_FillRadialGradient(&oled.gfx, &oled, 48, 32, 48, 32, 72, 48, 24, SSD1331_WHITE, SSD1331_BLUE, true);
+}
+
 //==============================================================================
 // TEXT AND DISPLAY TESTS
 //==============================================================================
@@ -435,6 +564,30 @@ void tftPrintTest(void) {
     GFX_Print(&oled.gfx, &oled, "seconds.");
 }
 
+/**
+ * @brief Test the scrolling text console
+ * 
+ * Prints more log lines than fit below a fixed title; each new line
+ * scrolls the region with the controller's copy command.
+ */
+void testconsole(void) {
+    GFX_Console_t con;
+    
+    SSD1331_FillScreen(&oled, SSD1331_BLACK);
+    GFX_SetTextSize(&oled.gfx, 1);
+    GFX_SetTextColor(&oled.gfx, SSD1331_CYAN);
+    GFX_PrintAt(&oled.gfx, &oled, 0, 0, "Event log");
+    
+    GFX_SetTextColorBg(&oled.gfx, SSD1331_WHITE, SSD1331_BLACK);
+    GFX_ConsoleInit(&oled.gfx, &con, 0, 8, oled.gfx.width, oled.gfx.height - 8);
+    
+    for (uint8_t i = 0; i < 20; i++) {
+        sprintf(buffer, "event %u\n", i);
+        GFX_ConsolePrint(&oled.gfx, &oled, &con, buffer);
+        __delay_ms(100);
+    }
+}
+
 /**
  * @brief Display LCD test pattern
  * 
@@ -458,6 +611,35 @@ void lcdTestPattern(void) {
     }
 }
 
+/**
+ * @brief Render one gradient line for testscanlines
+ * 
+ * Red grows from left to right, blue from top to bottom.
+ * 
+ * @param context Unused
+ * @param row Y coordinate of the line
+ * @param line Buffer for the RGB565 pixels, high byte first
+ * @param w Number of pixels in the line
+ */
+static void gradientLine(void *context, int16_t row, uint8_t *line, int16_t w) {
+    uint16_t blue = (uint16_t)(row * 32 / oled.gfx.height);
+
+    for (int16_t x = 0; x < w; x++) {
+        uint16_t color = ((uint16_t)(x * 32 / w) << 11) | blue;
+        *line++ = color >> 8;
+        *line++ = color & 0xFF;
+    }
+}
+
+/**
+ * @brief Test the scanline pipeline with a full-screen gradient
+ * 
+ * Each line is computed in software while the previous one is being sent.
+ */
+void testscanlines(void) {
+    SSD1331_DrawScanlines(&oled, 0, 0, oled.gfx.width, oled.gfx.height, gradientLine, NULL, NULL);
+}
+
 //==============================================================================
 // IMAGE DISPLAY TESTS
 //==============================================================================
@@ -476,7 +658,11 @@ void testimages(void) {
     __delay_ms(DELAY_LONG); 
     
     
-    // Display second test image (8 bit array)           
+    // Display second test image (8 bit array)
+#ifdef SSD1331_USE_DMA
+    SSD1331_DrawFastRGBBitmap8_DMA(&oled, 0, 0, lena8b, SSD1331_WIDTH, SSD1331_HEIGHT, SSD1331_DMA_SRC_FLASH);
+#else
     SSD1331_DrawFastRGBBitmap8(&oled, 0, 0, lena8b, SSD1331_WIDTH, SSD1331_HEIGHT);
+#endif
     __delay_ms(DELAY_LONG);
 }
\ No newline at end of file
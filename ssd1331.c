@@ -12,6 +12,7 @@
 
 #include "ssd1331.h"
 #include "gfx_pic.h"
+#include <stdlib.h>
 
 //==============================================================================
 // HELPER MACROS AND VARIABLES
@@ -20,20 +21,223 @@
 /** @brief Macro to swap two 16-bit values */
 #define ssd1331_swap(a, b) { int16_t t = a; a = b; b = t; }
 
-/** @brief Dummy variable for SPI read operations */
-uint8_t SPI_dummy;
+/** @brief Pixels packed per transmit-only burst by the bitmap and pixel writers */
+#define SSD1331_SWAP_PIXELS 16
+
+/** @brief Largest transfer count SPI1TCNT can hold (11 bits) */
+#define SSD1331_SPI_TCNT_MAX 2047u
+
+/**
+ * @brief Power-up command sequence (from Adafruit library)
+ *
+ * Every entry is sent with D/C low, so the whole table goes out as one
+ * command transaction.
+ */
+static const uint8_t ssd1331_init_cmds[] = {
+    SSD1331_CMD_DISPLAYOFF,                 // Turn off display during init
+    SSD1331_CMD_SETREMAP,       0x72,       // Default remap settings
+    SSD1331_CMD_STARTLINE,      0x00,       // Start from line 0
+    SSD1331_CMD_DISPLAYOFFSET,  0x00,       // No offset
+    SSD1331_CMD_NORMALDISPLAY,              // Normal display mode
+    SSD1331_CMD_SETMULTIPLEX,   0x3F,       // 1/64 duty cycle
+    SSD1331_CMD_SETMASTER,      0x8E,       // Master configuration
+    SSD1331_CMD_POWERMODE,      0x0B,       // Power mode
+    SSD1331_CMD_PRECHARGE,      0x31,       // Pre-charge period
+    SSD1331_CMD_CLOCKDIV,       0xF0,       // Display clock divide ratio
+    SSD1331_CMD_PRECHARGEA,     0x64,       // Second pre-charge speed, red
+    SSD1331_CMD_PRECHARGEB,     0x78,       // Second pre-charge speed, green
+    SSD1331_CMD_PRECHARGEC,     0x64,       // Second pre-charge speed, blue
+    SSD1331_CMD_PRECHARGELEVEL, 0x3A,       // Pre-charge voltage level
+    SSD1331_CMD_VCOMH,          0x3E,       // VCOMH voltage
+    SSD1331_CMD_MASTERCURRENT,  0x06,       // Master current control
+    SSD1331_CMD_CONTRASTA,      0x91,       // Red contrast
+    SSD1331_CMD_CONTRASTB,      0x50,       // Green contrast
+    SSD1331_CMD_CONTRASTC,      0x7D,       // Blue contrast
+    SSD1331_CMD_DISPLAYON                   // Turn on display
+};
 
 //==============================================================================
 // PRIVATE FUNCTION PROTOTYPES
 //==============================================================================
 
 static void SSD1331_HardwareReset(SSD1331_t *ssd);
+#ifndef SSD1331_USE_QUEUE
 static void SSD1331_Select(SSD1331_t *ssd);
 static void SSD1331_Deselect(SSD1331_t *ssd);
 static void SSD1331_SetDataMode(SSD1331_t *ssd);
 static void SSD1331_SetCommandMode(SSD1331_t *ssd);
-static void SSD1331_Xchange_Byte(SSD1331_t *ssd, uint8_t byte);
-static void SSD1331_Xchange_Block(SSD1331_t *ssd, void *block, size_t blockSize);
+#endif
+static void SSD1331_AdvanceWritePtr(SSD1331_t *ssd, uint16_t pixels);
+static void SSD1331_SendCommands(SSD1331_t *ssd, const uint8_t *cmds, uint8_t n);
+static void SSD1331_SendData(SSD1331_t *ssd, const uint8_t *data, uint8_t n);
+static void SSD1331_SendDataRef(SSD1331_t *ssd, const uint8_t *data, uint16_t n);
+static void SSD1331_SendRepeat(SSD1331_t *ssd, uint16_t color, uint16_t count);
+static bool SSD1331_ClipRect(SSD1331_t *ssd, int16_t *x, int16_t *y, int16_t *w, int16_t *h);
+static void SSD1331_PutRAMCoords(SSD1331_t *ssd, uint8_t *dst, int16_t x0, int16_t y0, int16_t x1, int16_t y1);
+static void SSD1331_PutColor(uint8_t *dst, uint16_t color);
+static void SSD1331_HardwareWait(SSD1331_t *ssd, uint16_t us);
+static void SSD1331_WriteRGB(SSD1331_t *ssd, const uint8_t *r, const uint8_t *g, const uint8_t *b,
+                             uint8_t step, uint16_t count);
+static void SSD1331_SPI_BeginTx(void);
+#if defined(SSD1331_USE_DMA) || defined(SSD1331_USE_QUEUE)
+static bool SSD1331_SPI_Drained(void);
+#endif
+#ifndef SSD1331_USE_QUEUE
+static void SSD1331_SPI_EndTx(void);
+static void SSD1331_SPI_WriteBlock(const uint8_t *data, uint16_t n);
+static void SSD1331_SPI_WriteRepeat(const uint8_t *pattern, uint8_t size, uint16_t count);
+#endif
+
+#ifdef SSD1331_USE_DMA
+//==============================================================================
+// DMA STREAMING STATE
+//==============================================================================
+
+/** @brief DMA1CON1 DSTP: clear SIRQEN when the destination counter reloads */
+#define SSD1331_DMA_CON1_DSTP       0x20
+
+/** @brief DMA1CON1 SMR: source is program flash memory */
+#define SSD1331_DMA_CON1_SMR_FLASH  0x08
+
+/** @brief DMA1CON1 SMODE: source pointer is incremented after each transfer */
+#define SSD1331_DMA_CON1_SMODE_INC  0x02
+
+/** @brief Bytes in one line buffer (a full-width RGB565 display row) */
+#define SSD1331_DMA_LINE_BYTES      (SSD1331_WIDTH * 2)
+
+/**
+ * @brief Kinds of transfer the DMA engine can run
+ */
+typedef enum {
+    SSD1331_DMA_JOB_FILL,  ///< Repeat a 2-byte RGB565 pattern
+    SSD1331_DMA_JOB_BLOCK, ///< Stream a contiguous source buffer in place
+    SSD1331_DMA_JOB_ROWS   ///< Stream rows staged through the line buffers
+} SSD1331_DMAJob_t;
+
+/**
+ * @brief State of the transfer currently owning DMA1 and SPI1
+ */
+static struct {
+    SSD1331_t *owner;          ///< Display being written, NULL when idle
+    SSD1331_DMAJob_t job;      ///< Kind of transfer
+    uint24_t src;              ///< Next source address (BLOCK)
+    uint8_t con1;              ///< DMA1CON1 value for BLOCK chunks
+    uint16_t remaining;        ///< Bytes not yet handed to the DMA (FILL/BLOCK)
+    const uint8_t *rows;       ///< Row source data (ROWS)
+    uint8_t row_bytes;         ///< Bytes per row (ROWS)
+    uint16_t row_stride;       ///< Source bytes from one row to the next (ROWS)
+    uint8_t rows_total;        ///< Number of rows to send (ROWS)
+    uint8_t rows_started;      ///< Rows already handed to the DMA (ROWS)
+    void (*stage)(uint8_t *dst, const uint8_t *src, uint8_t bytes); ///< Row copy routine
+    uint8_t pattern[2];        ///< Fill colour, high byte first (FILL)
+} ssd1331_dma;
+
+/** @brief Ping-pong line buffers: one is on the wire while the other is staged */
+static uint8_t ssd1331_dma_line[2][SSD1331_DMA_LINE_BYTES];
+
+static void SSD1331_DMA_Initialize(void);
+static void SSD1331_DMA_Wait(void);
+static void SSD1331_DMA_StageCopy(uint8_t *dst, const uint8_t *src, uint8_t bytes);
+static void SSD1331_DMA_StageSwap16(uint8_t *dst, const uint8_t *src, uint8_t bytes);
+static void SSD1331_DMA_Start(SSD1331_t *ssd, int16_t x, int16_t y, int16_t w, int16_t h);
+static void SSD1331_DMA_Run(SSD1331_t *ssd);
+static bool SSD1331_DMA_Next(void);
+static void SSD1331_DMA_Finish(void);
+#endif
+
+#ifdef SSD1331_USE_QUEUE
+//==============================================================================
+// ASYNCHRONOUS QUEUE STATE
+//==============================================================================
+
+/** @brief Index mask for the ring buffer */
+#define SSD1331_QUEUE_MASK       (SSD1331_QUEUE_SIZE - 1)
+
+/** @brief Largest inline payload per packet, so one packet always fits */
+#define SSD1331_QUEUE_INLINE_MAX (SSD1331_QUEUE_SIZE / 4)
+
+/** @brief Bytes per SPI1TCNT burst (the counter is 11 bits wide) */
+#define SSD1331_QUEUE_BURST      2047
+
+/** @brief NOP bytes that take at least a microsecond on the bus (SPI1BAUD 3: 8 MHz) */
+#define SSD1331_QUEUE_PAD_PER_US 1
+
+/**
+ * @brief Packet kinds stored in the ring buffer
+ *
+ * Each packet starts with its type byte, followed by:
+ * CMD/DATA: length, then the bytes themselves;
+ * DATA_REF: source pointer, then a 16-bit length;
+ * REPEAT: two pattern bytes, then a 16-bit repeat count;
+ * PAD: 16-bit number of NOP commands;
+ * CALLBACK: function pointer, then context pointer.
+ */
+typedef enum {
+    SSD1331_PKT_CMD,      ///< Inline command bytes (DC low)
+    SSD1331_PKT_DATA,     ///< Inline data bytes (DC high)
+    SSD1331_PKT_DATA_REF, ///< Data read from the caller's buffer (DC high)
+    SSD1331_PKT_REPEAT,   ///< 2-byte pattern sent 'count' times (DC high)
+    SSD1331_PKT_PAD,      ///< NOP commands that let a drawing command finish (DC low)
+    SSD1331_PKT_CALLBACK  ///< Called once every earlier byte is on the wire
+} SSD1331_Packet_t;
+
+/**
+ * @brief Ring buffer indices and the packet currently being sent
+ */
+static struct {
+    volatile uint8_t head;   ///< Next free byte, written by the producer only
+    volatile uint8_t tail;   ///< Next byte to send, written by the ISR only
+    volatile bool active;    ///< CS held low and SPI1TXIE enabled
+    uint8_t wr;              ///< Producer scratch index of an uncommitted packet
+    uint8_t type;            ///< Packet being sent
+    uint16_t remaining;      ///< Bytes left in the packet being sent
+    uint16_t burst;          ///< Bytes left in the current SPI1TCNT burst
+    const uint8_t *ref;      ///< Source of a DATA_REF packet
+    uint8_t pattern[2];      ///< Pattern of a REPEAT packet
+    uint8_t phase;           ///< Index of the next pattern byte
+#ifdef SSD1331_QUEUE_DROP
+    bool resync;             ///< A packet was dropped: pixel data waits for the next command
+#endif
+} ssd1331_q;
+
+/** @brief Ring buffer holding encoded packets */
+static uint8_t ssd1331_q_buf[SSD1331_QUEUE_SIZE];
+
+static void SSD1331_SendPad(SSD1331_t *ssd, uint16_t count);
+static uint8_t SSD1331_Queue_Room(void);
+static bool SSD1331_Queue_Reserve(SSD1331_t *ssd, uint8_t bytes, uint8_t type);
+static void SSD1331_Queue_Put(const void *src, uint8_t n);
+static void SSD1331_Queue_Commit(void);
+static void SSD1331_Queue_Get(void *dst, uint8_t n);
+static bool SSD1331_Queue_Load(void);
+static void SSD1331_Queue_Service(void);
+#endif
+
+//==============================================================================
+// SCANLINE PIPELINE STATE
+//==============================================================================
+
+#ifdef SSD1331_USE_DMA
+/** @brief Shared with ROWS jobs: SSD1331_DrawScanlines waits for the DMA first */
+#define ssd1331_scan_line ssd1331_dma_line
+
+/** @brief Line buffer handed to the DMA most recently */
+static uint8_t ssd1331_scan_sending;
+#else
+/** @brief Ping-pong line buffers: one is filled while the other is sent */
+static uint8_t ssd1331_scan_line[2][SSD1331_WIDTH * 2];
+#endif
+
+#ifdef SSD1331_USE_QUEUE
+/** @brief Set while a line buffer is queued, cleared by a queued callback */
+static volatile bool ssd1331_scan_busy[2];
+
+static void SSD1331_Scanline_Done(void *context);
+#endif
+
+static bool SSD1331_Scanline_Busy(SSD1331_t *ssd, uint8_t i);
+static void SSD1331_Scanline_Wait(SSD1331_t *ssd, uint8_t i);
+static void SSD1331_Scanline_Send(SSD1331_t *ssd, uint8_t i, uint8_t offset, uint8_t bytes);
 
 
 //==============================================================================
@@ -50,6 +254,21 @@ void SSD1331_Delay(uint16_t ms) {
     }
 }
 
+/**
+ * @brief Convert RGB888 color to RGB565 format
+ * 
+ * Truncates each channel to its top bits. For whole rows of RGB888
+ * pixels, SSD1331_WriteRGB888 converts with dithering while streaming.
+ * 
+ * @param r Red component (0-255)
+ * @param g Green component (0-255)
+ * @param b Blue component (0-255)
+ * @return Color value in RGB565 format
+ */
+uint16_t SSD1331_Color565(uint8_t r, uint8_t g, uint8_t b) {
+    return (uint16_t)(((uint16_t)(r & 0xF8) << 8) | ((uint16_t)(g & 0xFC) << 3) | (b >> 3));
+}
+
 //==============================================================================
 // INITIALIZATION FUNCTIONS
 //==============================================================================
@@ -65,6 +284,18 @@ void SSD1331_Delay(uint16_t ms) {
 void SSD1331_Init(SSD1331_t *ssd) {
     // Initialize rotation
     ssd->rotation = 0;
+    
+    // Controller window is unknown until the first SetAddrWindow
+    ssd->win_valid = false;
+    
+#ifdef SSD1331_USE_DMA
+    ssd->dma_busy = false;
+    ssd->dma_callback = NULL;
+    ssd->dma_context = NULL;
+#endif
+#ifdef SSD1331_USE_QUEUE
+    ssd->queue_dropped = 0;
+#endif
 
     // Initialize graphics context with display dimensions
     GFX_Init(&ssd->gfx, SSD1331_WIDTH, SSD1331_HEIGHT);
@@ -73,12 +304,20 @@ void SSD1331_Init(SSD1331_t *ssd) {
     // This prevents recursion by letting GFX library handle complex operations
     ssd->gfx.drawPixel = (void*)SSD1331_DrawPixel;
     ssd->gfx.writePixel = (void*)SSD1331_WriteData16;
+    ssd->gfx.setAddrWindow = (void*)SSD1331_SetAddrWindow;
+    ssd->gfx.writeColor = (void*)SSD1331_WriteColor;
+    ssd->gfx.writePixels = (void*)SSD1331_WritePixels;
+    ssd->gfx.fillRect = (void*)SSD1331_FillRect;
+    ssd->gfx.drawLine = (void*)SSD1331_DrawLine;
+    ssd->gfx.drawRect = (void*)SSD1331_DrawRect;
+    ssd->gfx.copyArea = (void*)SSD1331_CopyRect;
+    
+    // Spans stream straight to GDDRAM and never call back into GFX,
+    // so registering them cannot recurse
+    ssd->gfx.drawFastVLine = (void*)SSD1331_DrawFastVLine;
+    ssd->gfx.drawFastHLine = (void*)SSD1331_DrawFastHLine;
     
     // Leave other functions as NULL to use GFX library fallbacks
-    // This avoids recursion issues:
-    // ssd->gfx.fillRect      = NULL; 
-    // ssd->gfx.drawFastVLine = NULL;
-    // ssd->gfx.drawFastHLine = NULL;
     // ssd->gfx.fillScreen    = NULL;
 
     // Initialize GPIO pins to default states
@@ -99,77 +338,19 @@ void SSD1331_Begin(SSD1331_t *ssd) {
     // Initialize SPI peripheral
     SPI1_Open(SPI1_DEFAULT);
     
+#ifdef SSD1331_USE_DMA
+    SSD1331_DMA_Initialize();
+#endif
+#ifdef SSD1331_USE_QUEUE
+    // Nothing may be in flight while the controller is reset
+    SSD1331_Flush(ssd);
+#endif
+
     // Perform hardware reset sequence
     SSD1331_HardwareReset(ssd);
 
     // Initialization sequence from Adafruit Library
-    SSD1331_WriteCommand(ssd, SSD1331_CMD_DISPLAYOFF);      // Turn off display during init
-    
-    // Set display re-mapping and color depth
-    SSD1331_WriteCommand(ssd, SSD1331_CMD_SETREMAP);        
-    SSD1331_WriteCommand(ssd, 0x72);                        // Default remap settings
-    
-    // Set display start line
-    SSD1331_WriteCommand(ssd, SSD1331_CMD_STARTLINE);       
-    SSD1331_WriteCommand(ssd, 0x00);                        // Start from line 0
-    
-    // Set display offset
-    SSD1331_WriteCommand(ssd, SSD1331_CMD_DISPLAYOFFSET);   
-    SSD1331_WriteCommand(ssd, 0x00);                        // No offset
-    
-    // Set normal display mode
-    SSD1331_WriteCommand(ssd, SSD1331_CMD_NORMALDISPLAY);   
-    
-    // Set multiplex ratio (1/64 duty cycle)
-    SSD1331_WriteCommand(ssd, SSD1331_CMD_SETMULTIPLEX);    
-    SSD1331_WriteCommand(ssd, 0x3F);                        
-    
-    // Set master configuration
-    SSD1331_WriteCommand(ssd, SSD1331_CMD_SETMASTER);       
-    SSD1331_WriteCommand(ssd, 0x8E);
-    
-    // Set power mode
-    SSD1331_WriteCommand(ssd, SSD1331_CMD_POWERMODE);       
-    SSD1331_WriteCommand(ssd, 0x0B);
-    
-    // Set pre-charge period
-    SSD1331_WriteCommand(ssd, SSD1331_CMD_PRECHARGE);       
-    SSD1331_WriteCommand(ssd, 0x31);
-    
-    // Set display clock divide ratio
-    SSD1331_WriteCommand(ssd, SSD1331_CMD_CLOCKDIV);        
-    SSD1331_WriteCommand(ssd, 0xF0);
-    
-    // Set second pre-charge speeds for each color
-    SSD1331_WriteCommand(ssd, SSD1331_CMD_PRECHARGEA);      // Red
-    SSD1331_WriteCommand(ssd, 0x64);
-    SSD1331_WriteCommand(ssd, SSD1331_CMD_PRECHARGEB);      // Green
-    SSD1331_WriteCommand(ssd, 0x78);
-    SSD1331_WriteCommand(ssd, SSD1331_CMD_PRECHARGEC);      // Blue
-    SSD1331_WriteCommand(ssd, 0x64);
-    
-    // Set pre-charge voltage level
-    SSD1331_WriteCommand(ssd, SSD1331_CMD_PRECHARGELEVEL);  
-    SSD1331_WriteCommand(ssd, 0x3A);
-    
-    // Set VCOMH voltage
-    SSD1331_WriteCommand(ssd, SSD1331_CMD_VCOMH);           
-    SSD1331_WriteCommand(ssd, 0x3E);
-    
-    // Set master current control
-    SSD1331_WriteCommand(ssd, SSD1331_CMD_MASTERCURRENT);   
-    SSD1331_WriteCommand(ssd, 0x06);
-    
-    // Set individual RGB contrast levels
-    SSD1331_WriteCommand(ssd, SSD1331_CMD_CONTRASTA);       // Red contrast
-    SSD1331_WriteCommand(ssd, 0x91);
-    SSD1331_WriteCommand(ssd, SSD1331_CMD_CONTRASTB);       // Green contrast
-    SSD1331_WriteCommand(ssd, 0x50);
-    SSD1331_WriteCommand(ssd, SSD1331_CMD_CONTRASTC);       // Blue contrast
-    SSD1331_WriteCommand(ssd, 0x7D);
-    
-    // Turn on display
-    SSD1331_WriteCommand(ssd, SSD1331_CMD_DISPLAYON);       
+    SSD1331_WriteCommands(ssd, ssd1331_init_cmds, sizeof(ssd1331_init_cmds));
     
     // Set initial rotation
     SSD1331_SetRotation(ssd, SSD1331_INIT_ROTATION);
@@ -241,8 +422,12 @@ void SSD1331_SetRotation(SSD1331_t *ssd, uint8_t r) {
     }
     
     // Send re-map command to display
-    SSD1331_WriteCommand(ssd, SSD1331_CMD_SETREMAP);
-    SSD1331_WriteCommand(ssd, madctl);
+    uint8_t cmds[2] = { SSD1331_CMD_SETREMAP, madctl };
+    SSD1331_WriteCommands(ssd, cmds, 2);
+    
+    // Logical coordinates map to different GDDRAM addresses now
+    ssd->win_valid = false;
+    GFX_ResetClip(&ssd->gfx);
 }
 
 //==============================================================================
@@ -284,35 +469,61 @@ void SSD1331_SetAddrWindow(SSD1331_t *ssd, uint16_t x, uint16_t y, uint16_t w, u
 */
     
     uint8_t aux = ssd->rotation;    
+    uint8_t cmds[6];
     
+    // Nothing to send when the window is unchanged and the write pointer
+    // has wrapped back to its origin
+    if (ssd->win_valid &&
+        ssd->win_x0 == x1 && ssd->win_y0 == y1 &&
+        ssd->win_x1 == x2 && ssd->win_y1 == y2 &&
+        ssd->wr_x == x1 && ssd->wr_y == y1) {
+        return;
+    }
     
+    // Column and row ranges go out together in one transaction
+    cmds[0] = SSD1331_CMD_SETCOLUMN;
+    cmds[3] = SSD1331_CMD_SETROW;
     if (aux == 0 || aux == 2)
     {
-        SSD1331_WriteCommand(ssd, SSD1331_CMD_SETCOLUMN);
-        SSD1331_WriteCommand(ssd, x1);
-        SSD1331_WriteCommand(ssd, x2);
-
-        SSD1331_WriteCommand(ssd, SSD1331_CMD_SETROW);
-        SSD1331_WriteCommand(ssd, y1);
-        SSD1331_WriteCommand(ssd, y2);
+        cmds[1] = x1;
+        cmds[2] = x2;
+        cmds[4] = y1;
+        cmds[5] = y2;
     }
     else
         {
-        SSD1331_WriteCommand(ssd, SSD1331_CMD_SETCOLUMN);
-        SSD1331_WriteCommand(ssd, y1);
-        SSD1331_WriteCommand(ssd, y2);
-
-        SSD1331_WriteCommand(ssd, SSD1331_CMD_SETROW);
-        SSD1331_WriteCommand(ssd, x1);
-        SSD1331_WriteCommand(ssd, x2);
+        cmds[1] = y1;
+        cmds[2] = y2;
+        cmds[4] = x1;
+        cmds[5] = x2;
+    }
+    SSD1331_WriteCommands(ssd, cmds, 6);
+    
+    // Only windows that lie inside the display can be tracked reliably
+    ssd->win_x0 = x1;
+    ssd->win_y0 = y1;
+    ssd->win_x1 = x2;
+    ssd->win_y1 = y2;
+    ssd->wr_x = x1;
+    ssd->wr_y = y1;
+    ssd->win_valid = (x1 <= x2) && (y1 <= y2) &&
+                     (x2 < ssd->gfx.width) && (y2 < ssd->gfx.height);
+#ifdef SSD1331_QUEUE_DROP
+    // The window command itself may have been dropped
+    if (ssd1331_q.resync) {
+        ssd->win_valid = false;
     }
+#endif
 }
 
 
 /**
  * @brief Draw a single pixel at specified coordinates
  * 
- * Sets address window to single pixel and writes color data.
+ * Writes the color directly when GDDRAM auto-increment already points at
+ * (x, y). Otherwise opens a window from (x, y) to the bottom-right corner
+ * of the display, so pixels drawn afterwards in scan order stream without
+ * further window commands.
  * Automatically clips coordinates to display boundaries.
  * 
  * @param ssd Pointer to SSD1331 driver structure
@@ -321,50 +532,177 @@ void SSD1331_SetAddrWindow(SSD1331_t *ssd, uint16_t x, uint16_t y, uint16_t w, u
  * @param color Pixel color in RGB565 format
  */
 void SSD1331_DrawPixel(SSD1331_t *ssd, int16_t x, int16_t y, uint16_t color) {
-    // Check bounds
-    if ((x < 0) || (x >= ssd->gfx.width) || (y < 0) || (y >= ssd->gfx.height)) {
+    // Check against the clip rectangle (always inside the display)
+    if ((x < ssd->gfx.clip.x0) || (x > ssd->gfx.clip.x1) || (y < ssd->gfx.clip.y0) || (y > ssd->gfx.clip.y1)) {
         return;
     }
     
-    // Set address window for single pixel and write color
-    SSD1331_SetAddrWindow(ssd, (uint16_t)x, (uint16_t)y, 1, 1);
+    // Reopen the window only if auto-increment won't land on (x, y)
+    if (!ssd->win_valid || ssd->wr_x != (uint8_t)x || ssd->wr_y != (uint8_t)y) {
+        SSD1331_SetAddrWindow(ssd, (uint16_t)x, (uint16_t)y,
+                              (uint16_t)(ssd->gfx.width - x), (uint16_t)(ssd->gfx.height - y));
+    }
     SSD1331_WriteData16(ssd, color);
 }
 
 /**
  * @brief Fill entire screen with specified color
  * 
- * Uses GFX library's fillScreen implementation which will call
- * the assigned drawPixel function for each pixel.
+ * Uses the controller's rectangle fill, so only a few command bytes
+ * are sent instead of every pixel.
  * 
  * @param ssd Pointer to SSD1331 driver structure
  * @param color Fill color in RGB565 format
  */
 void SSD1331_FillScreen(SSD1331_t *ssd, uint16_t color) {
-    //GFX_FillScreen(&ssd->gfx, ssd, color);
+    SSD1331_FillRect(ssd, 0, 0, ssd->gfx.width, ssd->gfx.height, color);
+}
+
+/**
+ * @brief Draw a horizontal span
+ * 
+ * Opens a one-row window and streams the run in a single data transfer.
+ * Spans never use the line engine: with the recommended wait even a
+ * full-width run is sent sooner than a hardware line would finish, and
+ * SSD1331_DrawLine draws short lines through these spans. Registered as
+ * gfx.drawFastHLine.
+ * 
+ * @param ssd Pointer to SSD1331 driver structure
+ * @param x Starting X coordinate
+ * @param y Y coordinate of the span
+ * @param w Span length in pixels
+ * @param color Span color in RGB565 format
+ */
+void SSD1331_DrawFastHLine(SSD1331_t *ssd, int16_t x, int16_t y, int16_t w, uint16_t color) {
+    int16_t h = 1;
     
-    SSD1331_SetAddrWindow(ssd, (uint16_t)0, (uint16_t)0, (uint16_t)ssd->gfx.width, (uint16_t)ssd->gfx.height);
+    if (!SSD1331_ClipRect(ssd, &x, &y, &w, &h)) {
+        return;
+    }
     
-    SSD1331_Select(ssd);
-    SSD1331_SetDataMode(ssd);
+    SSD1331_SetAddrWindow(ssd, (uint16_t)x, (uint16_t)y, (uint16_t)w, 1);
+    SSD1331_SendRepeat(ssd, color, (uint16_t)w);
+    SSD1331_AdvanceWritePtr(ssd, (uint16_t)w);
+}
+
+/**
+ * @brief Draw a vertical span
+ * 
+ * Same as SSD1331_DrawFastHLine for a one-column window. Registered as
+ * gfx.drawFastVLine.
+ * 
+ * @param ssd Pointer to SSD1331 driver structure
+ * @param x X coordinate of the span
+ * @param y Starting Y coordinate
+ * @param h Span length in pixels
+ * @param color Span color in RGB565 format
+ */
+void SSD1331_DrawFastVLine(SSD1331_t *ssd, int16_t x, int16_t y, int16_t h, uint16_t color) {
+    int16_t w = 1;
     
-    // Calculate total number of pixels to transfer
-    uint32_t total_pixels = (uint32_t)ssd->gfx.width * ssd->gfx.height;
+    if (!SSD1331_ClipRect(ssd, &x, &y, &w, &h)) {
+        return;
+    }
     
-    // Send each pixel as two bytes (high byte first, then low byte)
-    for (uint32_t p = 0; p < total_pixels; p++) {
-        SSD1331_Xchange_Byte(ssd, color >> 8);    // Send high byte (bits 15-8)
-        SSD1331_Xchange_Byte(ssd, color & 0xFF);  // Send low byte (bits 7-0)
-    }    
+    SSD1331_SetAddrWindow(ssd, (uint16_t)x, (uint16_t)y, 1, (uint16_t)h);
+    SSD1331_SendRepeat(ssd, color, (uint16_t)h);
+    SSD1331_AdvanceWritePtr(ssd, (uint16_t)h);
+}
+
+/**
+ * @brief Draw a line between two points using hardware acceleration
+ * 
+ * The controller does not clip, so the line is clipped analytically to
+ * the GFX clip rectangle first. A line that can be streamed sooner than
+ * the engine's SSD1331_HW_LINE_MIN_US wait is over is drawn as run
+ * slices by GFX_WriteLine instead; with the recommended wait that is
+ * every line that fits the panel. Registered as gfx.drawLine.
+ * 
+ * @param ssd Pointer to SSD1331 driver structure
+ * @param x0 X coordinate of start point
+ * @param y0 Y coordinate of start point
+ * @param x1 X coordinate of end point
+ * @param y1 Y coordinate of end point
+ * @param color Line color in RGB565 format
+ */
+void SSD1331_DrawLine(SSD1331_t *ssd, int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint16_t color) {
+    uint8_t cmds[8];
+    
+    if (!GFX_ClipLine(&ssd->gfx, &x0, &y0, &x1, &y1)) {
+        return;
+    }
     
-    SSD1331_Deselect(ssd);  
+    // Streaming costs a 6-byte window per run plus 2 bytes per pixel, at
+    // about 1 us per byte
+    uint16_t dx = (uint16_t)abs(x1 - x0) + 1;
+    uint16_t dy = (uint16_t)abs(y1 - y0) + 1;
+    if ((dx > dy) ? (6 * dy + 2 * dx < SSD1331_HW_LINE_MIN_US) : (6 * dx + 2 * dy < SSD1331_HW_LINE_MIN_US)) {
+        GFX_WriteLine(&ssd->gfx, ssd, x0, y0, x1, y1, color);
+        return;
+    }
+    
+    cmds[0] = SSD1331_CMD_DRAWLINE;
+    SSD1331_PutRAMCoords(ssd, &cmds[1], x0, y0, x1, y1);
+    SSD1331_PutColor(&cmds[5], color);
+    SSD1331_WriteCommands(ssd, cmds, 8);
+    
+    SSD1331_HardwareWait(ssd, SSD1331_HW_LINE_MIN_US);
+}
+
+/**
+ * @brief Draw rectangle outline using hardware acceleration
+ * 
+ * A fully visible rectangle whose outline reaches SSD1331_HW_OUTLINE_MIN
+ * pixels is a single draw-rectangle command with fill disabled. Smaller
+ * or partly clipped rectangles are drawn as four spans, which clip
+ * themselves. With the recommended SSD1331_HW_FILL_MIN_US no outline on
+ * the panel is large enough, so the command is only used once the wait
+ * has been lowered for a timed panel. Registered as gfx.drawRect.
+ * 
+ * @param ssd Pointer to SSD1331 driver structure
+ * @param x X coordinate of top-left corner
+ * @param y Y coordinate of top-left corner
+ * @param w Rectangle width in pixels
+ * @param h Rectangle height in pixels
+ * @param color Outline color in RGB565 format
+ */
+void SSD1331_DrawRect(SSD1331_t *ssd, int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {
+    uint8_t cmds[13];
+    int16_t x1 = x + w - 1;
+    int16_t y1 = y + h - 1;
+    int16_t cx = x, cy = y, cw = w, ch = h;
+    
+    if (!SSD1331_ClipRect(ssd, &cx, &cy, &cw, &ch)) {
+        return;
+    }
+    
+    // Each edge clips itself
+    if ((cw != w) || (ch != h) || ((uint16_t)(w + h) * 2 < SSD1331_HW_OUTLINE_MIN)) {
+        SSD1331_DrawFastHLine(ssd, x, y, w, color);      // Top edge
+        SSD1331_DrawFastHLine(ssd, x, y1, w, color);     // Bottom edge
+        SSD1331_DrawFastVLine(ssd, x, y, h, color);      // Left edge
+        SSD1331_DrawFastVLine(ssd, x1, y, h, color);     // Right edge
+        return;
+    }
+    
+    cmds[0] = SSD1331_CMD_FILL;
+    cmds[1] = 0x00;                     // Outline only
+    cmds[2] = SSD1331_CMD_DRAWRECT;
+    SSD1331_PutRAMCoords(ssd, &cmds[3], x, y, x1, y1);
+    SSD1331_PutColor(&cmds[7], color);          // Outline
+    SSD1331_PutColor(&cmds[10], color);         // Fill (unused)
+    SSD1331_WriteCommands(ssd, cmds, 13);
+    
+    SSD1331_HardwareWait(ssd, SSD1331_HW_FILL_MIN_US);
 }
 
 /**
  * @brief Fill rectangular area with specified color
  * 
- * Uses GFX library's fillRect implementation which will call
- * the assigned drawPixel function for each pixel in the rectangle.
+ * Large areas use the controller's draw-rectangle command with fill
+ * enabled (or the clear-window command for black), then wait for the
+ * drawing engine to finish. Areas under SSD1331_HW_AREA_MIN pixels are
+ * streamed instead. Registered as gfx.fillRect.
  * 
  * @param ssd Pointer to SSD1331 driver structure
  * @param x X coordinate of top-left corner
@@ -374,7 +712,33 @@ void SSD1331_FillScreen(SSD1331_t *ssd, uint16_t color) {
  * @param color Fill color in RGB565 format
  */
 void SSD1331_FillRect(SSD1331_t *ssd, int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {
-    GFX_FillRect(&ssd->gfx, ssd, x, y, w, h, color);    
+    uint8_t cmds[13];
+    
+    // The controller does not clip drawing commands
+    if (!SSD1331_ClipRect(ssd, &x, &y, &w, &h)) {
+        return;
+    }
+    
+    // Small areas are sent sooner than the drawing engine's wait is over
+    if ((uint16_t)w * (uint16_t)h < SSD1331_HW_AREA_MIN) {
+        SSD1331_FillRect_Fast(ssd, x, y, w, h, color);
+        return;
+    }
+    
+    if (color == SSD1331_BLACK) {
+        SSD1331_ClearWindow(ssd, (uint8_t)x, (uint8_t)y, (uint8_t)(x + w - 1), (uint8_t)(y + h - 1));
+        return;
+    }
+    
+    cmds[0] = SSD1331_CMD_FILL;
+    cmds[1] = 0x01;                     // Fill rectangles
+    cmds[2] = SSD1331_CMD_DRAWRECT;
+    SSD1331_PutRAMCoords(ssd, &cmds[3], x, y, x + w - 1, y + h - 1);
+    SSD1331_PutColor(&cmds[7], color);          // Outline
+    SSD1331_PutColor(&cmds[10], color);         // Fill
+    SSD1331_WriteCommands(ssd, cmds, 13);
+    
+    SSD1331_HardwareWait(ssd, SSD1331_HW_FILL_MIN_US);
 }
 
 /**
@@ -390,23 +754,31 @@ void SSD1331_FillRect(SSD1331_t *ssd, int16_t x, int16_t y, int16_t w, int16_t h
  * @param color Fill color in RGB565 format
  */
 void SSD1331_FillRect_Fast(SSD1331_t *ssd, int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {
+    // Off-screen extents would wrap around inside the window
+    if (!SSD1331_ClipRect(ssd, &x, &y, &w, &h)) {
+        return;
+    }
     
+#ifdef SSD1331_USE_DMA
+    // Repeat the 2-byte colour from RAM for every pixel of the window
+    SSD1331_DMA_Wait();
+    ssd1331_dma.job = SSD1331_DMA_JOB_FILL;
+    ssd1331_dma.pattern[0] = color >> 8;
+    ssd1331_dma.pattern[1] = color & 0xFF;
+    ssd1331_dma.remaining = (uint16_t)w * (uint16_t)h * 2;
+    SSD1331_DMA_Start(ssd, x, y, w, h);
+    return;
+#endif
+
     // Set address window for the bitmap area
     SSD1331_SetAddrWindow(ssd, (uint16_t)x, (uint16_t)y, (uint16_t)w, (uint16_t)h);
     
-    SSD1331_Select(ssd);
-    SSD1331_SetDataMode(ssd);
-    
     // Calculate total number of pixels to transfer
     uint32_t total_pixels = (uint32_t)w * h;
     
     // Send each pixel as two bytes (high byte first, then low byte)
-    for (uint32_t p = 0; p < total_pixels; p++) {
-        SSD1331_Xchange_Byte(ssd, color >> 8);    // Send high byte (bits 15-8)
-        SSD1331_Xchange_Byte(ssd, color & 0xFF);  // Send low byte (bits 7-0)
-    }    
-    
-    SSD1331_Deselect(ssd);   
+    SSD1331_SendRepeat(ssd, color, (uint16_t)total_pixels);
+    SSD1331_AdvanceWritePtr(ssd, (uint16_t)total_pixels);
 }
 
 
@@ -432,29 +804,45 @@ void SSD1331_FillRect_Fast(SSD1331_t *ssd, int16_t x, int16_t y, int16_t w, int1
  * @note The bitmap data should be organized row by row, left to right
  * @note Total array size should be w * h uint16_t elements
  * @note Function validates input parameters and returns early if invalid
+ * @note With SSD1331_USE_DMA the function returns once the transfer has
+ *       started, and the interrupt handler keeps reading rows from bitmap.
+ *       Leave the bitmap unchanged (and in scope) until SSD1331_IsBusy()
+ *       returns false, or call SSD1331_WaitDMA() before reusing it.
  */
 void SSD1331_DrawFastRGBBitmap16(SSD1331_t *ssd, int16_t x, int16_t y, const uint16_t *bitmap, int16_t w, int16_t h) {
-    // Validate input parameters
-    if (bitmap == NULL || w <= 0 || h <= 0) {
+    int16_t cx = x, cy = y, cw = w, ch = h;
+    
+    // Validate input parameters and trim to the clip rectangle
+    if (bitmap == NULL || !SSD1331_ClipRect(ssd, &cx, &cy, &cw, &ch)) {
         return;
     }
     
-    // Set address window for the bitmap area
-    SSD1331_SetAddrWindow(ssd, (uint16_t)x, (uint16_t)y, (uint16_t)w, (uint16_t)h);
-    
-    SSD1331_Select(ssd);
-    SSD1331_SetDataMode(ssd);
-    
-    // Calculate total number of pixels to transfer
-    uint32_t total_pixels = (uint32_t)w * h;
+    // Skip clipped rows and columns; visible rows keep the source stride
+    bitmap += (uint16_t)(cy - y) * (uint16_t)w + (uint16_t)(cx - x);
     
-    // Send each pixel as two bytes (high byte first, then low byte)
-    for (uint32_t p = 0; p < total_pixels; p++) {
-        SSD1331_Xchange_Byte(ssd, bitmap[p] >> 8);    // Send high byte (bits 15-8)
-        SSD1331_Xchange_Byte(ssd, bitmap[p] & 0xFF);  // Send low byte (bits 7-0)
-    }    
+#ifdef SSD1331_USE_DMA
+    // uint16_t pixels are little-endian in memory, so each row is
+    // byte-swapped into a line buffer before the DMA sends it
+    SSD1331_DMA_Wait();
+    ssd1331_dma.job = SSD1331_DMA_JOB_ROWS;
+    ssd1331_dma.rows = (const uint8_t *)bitmap;
+    ssd1331_dma.row_bytes = (uint8_t)(cw * 2);
+    ssd1331_dma.row_stride = (uint16_t)w * 2;
+    ssd1331_dma.rows_total = (uint8_t)ch;
+    ssd1331_dma.stage = SSD1331_DMA_StageSwap16;
+    SSD1331_DMA_Start(ssd, cx, cy, cw, ch);
+    return;
+#endif
     
-    SSD1331_Deselect(ssd);
+    // Set address window for the visible area
+    SSD1331_SetAddrWindow(ssd, (uint16_t)cx, (uint16_t)cy, (uint16_t)cw, (uint16_t)ch);
+    if (cw == w) {
+        SSD1331_WritePixels(ssd, bitmap, (uint16_t)cw * (uint16_t)ch);
+    } else {
+        for (int16_t row = 0; row < ch; row++, bitmap += w) {
+            SSD1331_WritePixels(ssd, bitmap, (uint16_t)cw);
+        }
+    }
 }
 
 /**
@@ -480,130 +868,1501 @@ void SSD1331_DrawFastRGBBitmap16(SSD1331_t *ssd, int16_t x, int16_t y, const uin
  * @note Data format: [pixel0_high, pixel0_low, pixel1_high, pixel1_low, ...]
  * @note This function assumes the byte data is already in correct RGB565 format
  * @note Uses SPI block transfer for optimal performance
+ * @note With SSD1331_USE_DMA the function returns once the transfer has
+ *       started, and the interrupt handler keeps reading rows from bitmap.
+ *       Leave the bitmap unchanged (and in scope) until SSD1331_IsBusy()
+ *       returns false, or call SSD1331_WaitDMA() before reusing it.
+ * @note With SSD1331_USE_QUEUE the pixels are copied into the queue, so
+ *       the bitmap may be reused as soon as the function returns.
  */
 void SSD1331_DrawFastRGBBitmap8(SSD1331_t *ssd, int16_t x, int16_t y, const uint8_t *bitmap, int16_t w, int16_t h) {
-    // Validate input parameters
-    if (bitmap == NULL || w <= 0 || h <= 0) {
+    int16_t cx = x, cy = y, cw = w, ch = h;
+    
+    // Validate input parameters and trim to the clip rectangle
+    if (bitmap == NULL || !SSD1331_ClipRect(ssd, &cx, &cy, &cw, &ch)) {
         return;
     }
     
-    // Set address window for the bitmap area
-    SSD1331_SetAddrWindow(ssd, (uint16_t)x, (uint16_t)y, (uint16_t)w, (uint16_t)h);
+    // Skip clipped rows and columns; visible rows keep the source stride
+    bitmap += ((uint16_t)(cy - y) * (uint16_t)w + (uint16_t)(cx - x)) * 2;
     
-    SSD1331_Select(ssd);
-    SSD1331_SetDataMode(ssd);
+#ifdef SSD1331_USE_DMA
+    // The pointer may refer to RAM or flash, so rows are staged through
+    // the line buffers; use SSD1331_DrawFastRGBBitmap8_DMA for zero-copy
+    SSD1331_DMA_Wait();
+    ssd1331_dma.job = SSD1331_DMA_JOB_ROWS;
+    ssd1331_dma.rows = bitmap;
+    ssd1331_dma.row_bytes = (uint8_t)(cw * 2);
+    ssd1331_dma.row_stride = (uint16_t)w * 2;
+    ssd1331_dma.rows_total = (uint8_t)ch;
+    ssd1331_dma.stage = SSD1331_DMA_StageCopy;
+    SSD1331_DMA_Start(ssd, cx, cy, cw, ch);
+    return;
+#endif
     
-    // Calculate total number of pixels and bytes to transfer
-    uint32_t total_pixels = (uint32_t)w * h;
-    uint32_t total_bytes = total_pixels * 2;  // 2 bytes per pixel in RGB565
+    // Set address window for the visible area
+    SSD1331_SetAddrWindow(ssd, (uint16_t)cx, (uint16_t)cy, (uint16_t)cw, (uint16_t)ch);
     
-    // Send entire bitmap data in one block transfer for maximum performance
     // The bitmap data should already be in correct byte order (high, low per pixel)
-    //SPI1_ExchangeBlock(bitmap, total_bytes);
-    SSD1331_Xchange_Block(ssd, (void *)bitmap, (size_t)total_bytes);
-    
-    SSD1331_Deselect(ssd);
+#ifdef SSD1331_USE_QUEUE
+    // Copied into the queue, so the caller may reuse the bitmap at once
+    for (int16_t row = 0; row < ch; row++, bitmap += (uint16_t)w * 2) {
+        SSD1331_SendData(ssd, bitmap, (uint8_t)(cw * 2));
+    }
+#else
+    // Transmit-only, so the (possibly const) source is never written back
+    if (cw == w) {
+        // Unclipped rows are contiguous: send them in one block transfer
+        SSD1331_SendDataRef(ssd, bitmap, (uint16_t)cw * (uint16_t)ch * 2);
+    } else {
+        for (int16_t row = 0; row < ch; row++, bitmap += (uint16_t)w * 2) {
+            SSD1331_SendDataRef(ssd, bitmap, (uint16_t)cw * 2);
+        }
+    }
+#endif
+    SSD1331_AdvanceWritePtr(ssd, (uint16_t)cw * (uint16_t)ch);
 }
 
 //==============================================================================
-// SPI COMMUNICATION FUNCTIONS
+// HARDWARE-ACCELERATED SPECIAL FUNCTIONS
 //==============================================================================
 
-static void SSD1331_Xchange_Byte(SSD1331_t *ssd, uint8_t byte)
-{
-    SPI_dummy = SPI1_ExchangeByte(byte); // <-- 
-}
-
-
-static void SSD1331_Xchange_Block(SSD1331_t *ssd, void *block, size_t blockSize)
-{
-    // O parmetro 'ssd' no  usado aqui, mas  bom mant-lo por consistncia.
-    SPI1_ExchangeBlock(block, blockSize);
-}
-
-
 /**
- * @brief Send command byte to SSD1331 via SPI
+ * @brief Copy rectangular area to another location using hardware acceleration
  * 
- * Sets command mode (DC low), selects chip, sends byte, then deselects.
+ * Source and destination are clipped to the screen; overlapping areas are
+ * allowed. Waits SSD1331_HW_FILL_MIN_US for the drawing engine.
  * 
  * @param ssd Pointer to SSD1331 driver structure
- * @param cmd Command byte to send
+ * @param x0 Source area top-left X coordinate
+ * @param y0 Source area top-left Y coordinate
+ * @param x1 Source area bottom-right X coordinate
+ * @param y1 Source area bottom-right Y coordinate
+ * @param x2 Destination area top-left X coordinate
+ * @param y2 Destination area top-left Y coordinate
  */
-void SSD1331_WriteCommand(SSD1331_t *ssd, uint8_t cmd) {
-    SSD1331_Select(ssd);
-    SSD1331_SetCommandMode(ssd);
-    SSD1331_Xchange_Byte(ssd, cmd); // <-- CORREO
-    SSD1331_Deselect(ssd);
+void SSD1331_CopyArea(SSD1331_t *ssd, uint8_t x0, uint8_t y0, uint8_t x1, uint8_t y1, uint8_t x2, uint8_t y2) {
+    uint8_t cmds[9];
+    
+    if ((x0 >= ssd->gfx.width) || (y0 >= ssd->gfx.height) ||
+        (x2 >= ssd->gfx.width) || (y2 >= ssd->gfx.height) || (x1 < x0) || (y1 < y0)) {
+        return;
+    }
+    
+    // Keep both source and destination on-screen
+    if (x1 > ssd->gfx.width - 1) x1 = ssd->gfx.width - 1;
+    if (y1 > ssd->gfx.height - 1) y1 = ssd->gfx.height - 1;
+    if (x1 - x0 > ssd->gfx.width - 1 - x2) x1 = x0 + (ssd->gfx.width - 1 - x2);
+    if (y1 - y0 > ssd->gfx.height - 1 - y2) y1 = y0 + (ssd->gfx.height - 1 - y2);
+    
+    cmds[0] = SSD1331_CMD_COPY;
+    SSD1331_PutRAMCoords(ssd, &cmds[1], x0, y0, x1, y1);
+    SSD1331_PutRAMCoords(ssd, &cmds[5], x2, y2, x2, y2);  // Only the first pair is sent
+    SSD1331_WriteCommands(ssd, cmds, 7);
+    
+    SSD1331_HardwareWait(ssd, SSD1331_HW_FILL_MIN_US);
 }
 
 /**
- * @brief Send 16-bit data word to SSD1331 via SPI
+ * @brief Copy a rectangle given by position and size (gfx.copyArea)
  * 
- * Sets data mode (DC high), selects chip, sends high byte then low byte,
- * then deselects. Used for RGB565 pixel data.
+ * Clips the source rectangle to the screen, shifting the destination with
+ * it, so the controller only sees valid coordinates.
  * 
  * @param ssd Pointer to SSD1331 driver structure
- * @param data 16-bit data word to send (RGB565 pixel data)
+ * @param x Source top-left X coordinate
+ * @param y Source top-left Y coordinate
+ * @param w Width in pixels
+ * @param h Height in pixels
+ * @param x2 Destination top-left X coordinate
+ * @param y2 Destination top-left Y coordinate
  */
-void SSD1331_WriteData16(SSD1331_t *ssd, uint16_t data) {
-    SSD1331_Select(ssd);
-    SSD1331_SetDataMode(ssd);
+void SSD1331_CopyRect(SSD1331_t *ssd, int16_t x, int16_t y, int16_t w, int16_t h, int16_t x2, int16_t y2) {
+    int16_t sx = x, sy = y;
+    
+    if (!SSD1331_ClipRect(ssd, &sx, &sy, &w, &h)) {
+        return;
+    }
+    x2 += sx - x;
+    y2 += sy - y;
+    if ((x2 < 0) || (y2 < 0) || (x2 >= ssd->gfx.width) || (y2 >= ssd->gfx.height)) {
+        return;
+    }
     
-    SSD1331_Xchange_Byte(ssd, data >> 8);   // Envia o byte alto
-    SSD1331_Xchange_Byte(ssd, data & 0xFF);  // Envia o byte baixo
+    SSD1331_CopyArea(ssd, (uint8_t)sx, (uint8_t)sy, (uint8_t)(sx + w - 1), (uint8_t)(sy + h - 1),
+                     (uint8_t)x2, (uint8_t)y2);
+}
 
-    SSD1331_Deselect(ssd);
+/**
+ * @brief Clear (fill with black) specified window area using hardware acceleration
+ * @param ssd Pointer to SSD1331 driver structure
+ * @param x0 Window top-left X coordinate
+ * @param y0 Window top-left Y coordinate
+ * @param x1 Window bottom-right X coordinate
+ * @param y1 Window bottom-right Y coordinate
+ */
+void SSD1331_ClearWindow(SSD1331_t *ssd, uint8_t x0, uint8_t y0, uint8_t x1, uint8_t y1) {
+    uint8_t cmds[5];
+    
+    if ((x0 >= ssd->gfx.width) || (y0 >= ssd->gfx.height) || (x1 < x0) || (y1 < y0)) {
+        return;
+    }
+    if (x1 > ssd->gfx.width - 1) x1 = ssd->gfx.width - 1;
+    if (y1 > ssd->gfx.height - 1) y1 = ssd->gfx.height - 1;
+    
+    cmds[0] = SSD1331_CMD_CLEAR;
+    SSD1331_PutRAMCoords(ssd, &cmds[1], x0, y0, x1, y1);
+    SSD1331_WriteCommands(ssd, cmds, 5);
+    
+    SSD1331_HardwareWait(ssd, SSD1331_HW_FILL_MIN_US);
 }
 
 //==============================================================================
-// PRIVATE HELPER FUNCTIONS
+// SCANLINE PIPELINE FUNCTIONS
 //==============================================================================
 
 /**
- * @brief Perform hardware reset sequence on SSD1331
+ * @brief Draw a software-rendered area one line at a time
  * 
- * Toggles reset pin with appropriate delays to reset the display controller.
+ * Two line buffers alternate: while one line is on the wire (DMA or SPI
+ * queue interrupt), the fill callback renders the next one into the other
+ * buffer. Without SSD1331_USE_DMA or SSD1331_USE_QUEUE each line is sent
+ * before the next is rendered, so nothing overlaps.
+ * 
+ * Only rows inside the clip rectangle are rendered; the callback always
+ * fills the full width and the clipped columns are not sent.
  * 
  * @param ssd Pointer to SSD1331 driver structure
+ * @param x X coordinate of top-left corner
+ * @param y Y coordinate of top-left corner
+ * @param w Area width in pixels (at most SSD1331_WIDTH)
+ * @param h Area height in pixels
+ * @param fill Callback that renders one line
+ * @param context User pointer passed to the callback
+ * @param stats Optional overlap statistics (NULL if not needed)
  */
-static void SSD1331_HardwareReset(SSD1331_t *ssd) {
-    SSD1331_RST_SetHigh();  // Ensure reset is inactive
-    SSD1331_Delay(10);      // Wait for stability
-    SSD1331_RST_SetLow();   // Assert reset
-    SSD1331_Delay(10);      // Hold reset active
-    SSD1331_RST_SetHigh();  // Release reset
-    SSD1331_Delay(10);      // Wait for controller to initialize
+void SSD1331_DrawScanlines(SSD1331_t *ssd, int16_t x, int16_t y, int16_t w, int16_t h,
+                           SSD1331_ScanlineFill_t fill, void *context, SSD1331_ScanlineStats_t *stats) {
+    int16_t cx = x, cy = y, cw = w, ch = h;
+    uint8_t offset, bytes;
+    uint8_t i;
+    
+    if (stats != NULL) {
+        stats->lines = 0;
+        stats->overlapped = 0;
+    }
+    
+    // Validate input parameters and trim to the clip rectangle
+    if (fill == NULL || w > SSD1331_WIDTH || !SSD1331_ClipRect(ssd, &cx, &cy, &cw, &ch)) {
+        return;
+    }
+    offset = (uint8_t)((cx - x) * 2);
+    bytes = (uint8_t)(cw * 2);
+    
+#ifdef SSD1331_USE_DMA
+    // The line buffers are shared with ROWS jobs, and a cached window
+    // below does not wait for the bus, so let any transfer finish first
+    SSD1331_DMA_Wait();
+#endif
+    
+    SSD1331_SetAddrWindow(ssd, (uint16_t)cx, (uint16_t)cy, (uint16_t)cw, (uint16_t)ch);
+    
+    // Every line fills the window row by row, so the pointer ends up back
+    // at the window origin
+    SSD1331_AdvanceWritePtr(ssd, (uint16_t)cw * (uint16_t)ch);
+    
+    for (int16_t row = 0; row < ch; row++) {
+        i = row & 1;
+        
+        // This buffer was sent two lines ago; it must be off the wire
+        SSD1331_Scanline_Wait(ssd, i);
+        fill(context, cy + row, ssd1331_scan_line[i], w);
+        
+        if (stats != NULL) {
+            stats->lines++;
+            
+            // Rendering finished while the previous line was still sending
+            if (row > 0 && SSD1331_Scanline_Busy(ssd, i ^ 1)) {
+                stats->overlapped++;
+            }
+        }
+        
+        SSD1331_Scanline_Send(ssd, i, offset, bytes);
+    }
+    
+    // Callers may reuse the buffers' contents only once both are sent
+    SSD1331_Scanline_Wait(ssd, 0);
+    SSD1331_Scanline_Wait(ssd, 1);
 }
 
 /**
- * @brief Assert chip select (select SSD1331 for communication)
+ * @brief Check whether a line buffer is still being sent
  * @param ssd Pointer to SSD1331 driver structure
+ * @param i Line buffer index
+ * @return true while the buffer must not be modified
  */
-static void SSD1331_Select(SSD1331_t *ssd) { 
-    SSD1331_CS_SetLow(); 
+static bool SSD1331_Scanline_Busy(SSD1331_t *ssd, uint8_t i) {
+#if defined(SSD1331_USE_DMA)
+    // Only the most recently started line can still be in flight
+    return ssd->dma_busy && ssd1331_scan_sending == i;
+#elif defined(SSD1331_USE_QUEUE)
+    return ssd1331_scan_busy[i];
+#else
+    return false;
+#endif
 }
 
 /**
- * @brief Deassert chip select (end communication with SSD1331)
+ * @brief Block until a line buffer has been sent
  * @param ssd Pointer to SSD1331 driver structure
+ * @param i Line buffer index
  */
-static void SSD1331_Deselect(SSD1331_t *ssd) { 
-    SSD1331_CS_SetHigh(); 
+static void SSD1331_Scanline_Wait(SSD1331_t *ssd, uint8_t i) {
+#if defined(SSD1331_USE_DMA)
+    if (SSD1331_Scanline_Busy(ssd, i)) {
+        SSD1331_DMA_Wait();
+    }
+#elif defined(SSD1331_USE_QUEUE)
+    // Cleared by a queued callback once the line is on the wire
+    while (ssd1331_scan_busy[i]);
+#endif
 }
 
 /**
- * @brief Set data mode (DC high for data transmission)
+ * @brief Start sending a rendered line buffer into the current window
  * @param ssd Pointer to SSD1331 driver structure
+ * @param i Line buffer index
+ * @param offset Byte offset of the first visible pixel in the line
+ * @param bytes Number of bytes to send
  */
-static void SSD1331_SetDataMode(SSD1331_t *ssd) { 
-    SSD1331_DC_SetHigh(); 
+static void SSD1331_Scanline_Send(SSD1331_t *ssd, uint8_t i, uint8_t offset, uint8_t bytes) {
+#if defined(SSD1331_USE_DMA)
+    SSD1331_DMA_Wait();
+    ssd1331_dma.job = SSD1331_DMA_JOB_BLOCK;
+    ssd1331_dma.src = (uint24_t)&ssd1331_scan_line[i][offset];
+    ssd1331_dma.con1 = SSD1331_DMA_CON1_DSTP | SSD1331_DMA_CON1_SMODE_INC;
+    ssd1331_dma.remaining = bytes;
+    ssd1331_scan_sending = i;
+    SSD1331_DMA_Run(ssd);
+#elif defined(SSD1331_USE_QUEUE)
+    ssd1331_scan_busy[i] = true;
+    SSD1331_SendDataRef(ssd, &ssd1331_scan_line[i][offset], bytes);
+    if (!SSD1331_QueueCallback(ssd, SSD1331_Scanline_Done, (void *)&ssd1331_scan_busy[i])) {
+        ssd1331_scan_busy[i] = false;
+    }
+#else
+    SSD1331_SendDataRef(ssd, &ssd1331_scan_line[i][offset], bytes);
+#endif
 }
 
+#ifdef SSD1331_USE_QUEUE
 /**
- * @brief Set command mode (DC low for command transmission)
- * @param ssd Pointer to SSD1331 driver structure
+ * @brief Queued callback marking a line buffer as sent
+ * @param context Pointer to the buffer's busy flag
  */
-static void SSD1331_SetCommandMode(SSD1331_t *ssd) { 
-    SSD1331_DC_SetLow(); 
+static void SSD1331_Scanline_Done(void *context) {
+    *(volatile bool *)context = false;
+}
+#endif
+
+#ifdef SSD1331_USE_DMA
+//==============================================================================
+// DMA STREAMING FUNCTIONS
+//==============================================================================
+
+/**
+ * @brief Stream a raw RGB565 byte bitmap straight from memory with DMA1
+ * 
+ * DMA1 reads the bitmap in SSD1331_DMA_CHUNK sized bursts and writes each
+ * byte to SPI1TXB on the SPI1 transmit trigger. The function returns once
+ * the first burst is armed; completion is signalled through dma_busy and
+ * the registered callback.
+ * 
+ * @param ssd Pointer to SSD1331 driver structure
+ * @param x Starting X coordinate for bitmap placement (top-left corner)
+ * @param y Starting Y coordinate for bitmap placement (top-left corner)
+ * @param bitmap Pointer to raw RGB565 byte data (2 bytes per pixel)
+ * @param w Bitmap width in pixels
+ * @param h Bitmap height in pixels
+ * @param source Memory region of bitmap (RAM or program flash)
+ */
+void SSD1331_DrawFastRGBBitmap8_DMA(SSD1331_t *ssd, int16_t x, int16_t y, const uint8_t *bitmap, int16_t w, int16_t h, SSD1331_DMASource_t source) {
+    int16_t cx = x, cy = y, cw = w, ch = h;
+    
+    // Validate input parameters and trim to the clip rectangle
+    if (bitmap == NULL || !SSD1331_ClipRect(ssd, &cx, &cy, &cw, &ch)) {
+        return;
+    }
+    
+    // Rows cut at the left or right are no longer one contiguous block
+    if (cw != w) {
+        SSD1331_DrawFastRGBBitmap8(ssd, x, y, bitmap, w, h);
+        return;
+    }
+    bitmap += (uint16_t)(cy - y) * (uint16_t)w * 2;
+    
+    SSD1331_DMA_Wait();
+    ssd1331_dma.job = SSD1331_DMA_JOB_BLOCK;
+    ssd1331_dma.src = (uint24_t)bitmap;
+    ssd1331_dma.con1 = SSD1331_DMA_CON1_DSTP | SSD1331_DMA_CON1_SMODE_INC;
+    if (source == SSD1331_DMA_SRC_FLASH) {
+        ssd1331_dma.con1 |= SSD1331_DMA_CON1_SMR_FLASH;
+    }
+    ssd1331_dma.remaining = (uint16_t)cw * (uint16_t)ch * 2;
+    SSD1331_DMA_Start(ssd, cx, cy, cw, ch);
+}
+
+/**
+ * @brief Register the callback invoked when a DMA transfer completes
+ * 
+ * The callback runs in interrupt context after chip select has been
+ * released. It must be short and must not draw.
+ * 
+ * @param ssd Pointer to SSD1331 driver structure
+ * @param callback Function to call on completion (NULL to disable)
+ * @param context User pointer passed to the callback
+ */
+void SSD1331_SetDMACallback(SSD1331_t *ssd, SSD1331_Callback_t callback, void *context) {
+    SSD1331_DMA_Wait();
+    ssd->dma_callback = callback;
+    ssd->dma_context = context;
+}
+
+/**
+ * @brief Check whether a DMA transfer is still in progress
+ * @param ssd Pointer to SSD1331 driver structure
+ * @return true while the bus is owned by DMA
+ */
+bool SSD1331_IsBusy(SSD1331_t *ssd) {
+    return ssd->dma_busy;
+}
+
+/**
+ * @brief Block until the current DMA transfer has completed
+ * @param ssd Pointer to SSD1331 driver structure
+ */
+void SSD1331_WaitDMA(SSD1331_t *ssd) {
+    // Only SSD1331_InterruptHandler advances the transfer
+    while (ssd->dma_busy);
+}
+
+/**
+ * @brief Configure DMA1 for SPI1 transmit streaming
+ * 
+ * DMA1 is triggered by SPI1TXIF and writes one byte to SPI1TXB per
+ * trigger. The system arbiter must be locked before any DMA can run.
+ */
+static void SSD1331_DMA_Initialize(void) {
+    DMA1CON0 = 0x00;
+    DMA1SIRQ = SSD1331_DMA_SPI1TX_IRQ;
+    DMA1AIRQ = 0x00;
+    
+    PIR2bits.DMA1DCNTIF = 0;
+    PIE2bits.DMA1DCNTIE = 1;
+    
+    // Arbiter priorities only take effect once PRLOCK is set (one-way)
+    if (!PRLOCKbits.PRLOCKED) {
+        DMA1PR = 0x01;
+        PRLOCK = 0x55;
+        PRLOCK = 0xAA;
+        PRLOCKbits.PRLOCKED = 1;
+    }
+    
+    ssd1331_dma.owner = NULL;
+}
+
+/**
+ * @brief Wait until no DMA transfer owns the bus
+ */
+static void SSD1331_DMA_Wait(void) {
+    if (ssd1331_dma.owner != NULL) {
+        SSD1331_WaitDMA(ssd1331_dma.owner);
+    }
+}
+
+/**
+ * @brief Copy a row of big-endian RGB565 bytes into a line buffer
+ * @param dst Line buffer
+ * @param src Row source
+ * @param bytes Number of bytes in the row
+ */
+static void SSD1331_DMA_StageCopy(uint8_t *dst, const uint8_t *src, uint8_t bytes) {
+    while (bytes--) {
+        *dst++ = *src++;
+    }
+}
+
+/**
+ * @brief Copy a row of uint16_t RGB565 pixels into a line buffer, high byte first
+ * @param dst Line buffer
+ * @param src Row source (uint16_t pixels)
+ * @param bytes Number of bytes in the row
+ */
+static void SSD1331_DMA_StageSwap16(uint8_t *dst, const uint8_t *src, uint8_t bytes) {
+    const uint16_t *pixels = (const uint16_t *)src;
+    for (bytes >>= 1; bytes; bytes--) {
+        uint16_t color = *pixels++;
+        *dst++ = color >> 8;
+        *dst++ = color & 0xFF;
+    }
+}
+
+/**
+ * @brief Arm DMA1 for one burst into SPI1TXB
+ * @param src Source start address
+ * @param con1 DMA1CON1 value (source region and addressing mode)
+ * @param size Source size in bytes before the source pointer reloads
+ * @param count Number of bytes to transmit in this burst
+ */
+static void SSD1331_DMA_Kick(uint24_t src, uint8_t con1, uint16_t size, uint16_t count) {
+    DMA1CON0bits.EN = 0;
+    DMA1CON1 = con1;
+    DMA1SSA = src;
+    DMA1SSZ = size;
+    DMA1DSA = (uint16_t)(uint24_t)&SPI1TXB;
+    DMA1DSZ = count;
+    DMA1CON0bits.EN = 1;
+    
+    // SPI1 clocks out exactly 'count' bytes, then the DMA stops on DSTP
+    SPI1TCNT = count;
+    DMA1CON0bits.SIRQEN = 1;
+}
+
+/**
+ * @brief Set up the address window and start the prepared DMA job
+ * 
+ * The job fields of ssd1331_dma must be filled in by the caller.
+ * 
+ * @param ssd Pointer to SSD1331 driver structure
+ * @param x Window X coordinate
+ * @param y Window Y coordinate
+ * @param w Window width in pixels
+ * @param h Window height in pixels
+ */
+static void SSD1331_DMA_Start(SSD1331_t *ssd, int16_t x, int16_t y, int16_t w, int16_t h) {
+    SSD1331_SetAddrWindow(ssd, (uint16_t)x, (uint16_t)y, (uint16_t)w, (uint16_t)h);
+    
+    // The job fills the window exactly, so the cached write pointer can
+    // be updated before the bytes have actually gone out
+    SSD1331_AdvanceWritePtr(ssd, (uint16_t)w * (uint16_t)h);
+    
+    SSD1331_DMA_Run(ssd);
+}
+
+/**
+ * @brief Start the prepared DMA job into the current address window
+ * @param ssd Pointer to SSD1331 driver structure
+ */
+static void SSD1331_DMA_Run(SSD1331_t *ssd) {
+    SSD1331_Select(ssd);
+    SSD1331_SetDataMode(ssd);
+    
+    // Transmit-only: nothing is read back, so the RX FIFO can't stall DMA
+    SSD1331_SPI_BeginTx();
+    
+    if (ssd1331_dma.job == SSD1331_DMA_JOB_ROWS) {
+        ssd1331_dma.rows_started = 0;
+    }
+    
+    ssd1331_dma.owner = ssd;
+    ssd->dma_busy = true;
+    
+    // The interrupt handler starts the first burst, so DMA1 and the line
+    // buffers are only ever touched from interrupt context once a job runs
+    PIR2bits.DMA1DCNTIF = 1;
+}
+
+/**
+ * @brief Hand the next burst of the current job to the DMA
+ * 
+ * Called from the interrupt handler only, once SPI1 has sent every byte
+ * of the previous burst.
+ * 
+ * @return false when the job has no data left
+ */
+static bool SSD1331_DMA_Next(void) {
+    uint16_t count;
+    
+    if (ssd1331_dma.job == SSD1331_DMA_JOB_ROWS) {
+        if (ssd1331_dma.rows_started >= ssd1331_dma.rows_total) {
+            return false;
+        }
+        if (ssd1331_dma.rows_started == 0) {
+            ssd1331_dma.stage(ssd1331_dma_line[0], ssd1331_dma.rows, ssd1331_dma.row_bytes);
+        }
+        
+        // Send the staged row, then stage the following one into the
+        // buffer that just finished transmitting
+        SSD1331_DMA_Kick((uint24_t)ssd1331_dma_line[ssd1331_dma.rows_started & 1],
+                         SSD1331_DMA_CON1_DSTP | SSD1331_DMA_CON1_SMODE_INC,
+                         ssd1331_dma.row_bytes, ssd1331_dma.row_bytes);
+        ssd1331_dma.rows_started++;
+        
+        if (ssd1331_dma.rows_started < ssd1331_dma.rows_total) {
+            ssd1331_dma.stage(ssd1331_dma_line[ssd1331_dma.rows_started & 1],
+                              ssd1331_dma.rows + (uint16_t)ssd1331_dma.rows_started * ssd1331_dma.row_stride,
+                              ssd1331_dma.row_bytes);
+        }
+        return true;
+    }
+    
+    if (ssd1331_dma.remaining == 0) {
+        return false;
+    }
+    
+    count = (ssd1331_dma.remaining > SSD1331_DMA_CHUNK) ? SSD1331_DMA_CHUNK : ssd1331_dma.remaining;
+    ssd1331_dma.remaining -= count;
+    
+    if (ssd1331_dma.job == SSD1331_DMA_JOB_FILL) {
+        // 2-byte source reloads continuously; the destination count stops it
+        SSD1331_DMA_Kick((uint24_t)ssd1331_dma.pattern,
+                         SSD1331_DMA_CON1_DSTP | SSD1331_DMA_CON1_SMODE_INC, 2, count);
+    } else {
+        SSD1331_DMA_Kick(ssd1331_dma.src, ssd1331_dma.con1, count, count);
+        ssd1331_dma.src += count;
+    }
+    return true;
+}
+
+/**
+ * @brief Release the bus after the last burst and notify the owner
+ */
+static void SSD1331_DMA_Finish(void) {
+    SSD1331_t *ssd = ssd1331_dma.owner;
+    
+    DMA1CON0bits.EN = 0;
+    
+    // SPI1 has drained already: back to full duplex for SPI1_ExchangeByte users
+    SPI1CON2 = _SPI1CON2_SPI1RXR_MASK | _SPI1CON2_SPI1TXR_MASK;
+    SSD1331_CS_SetHigh();
+    
+    ssd1331_dma.owner = NULL;
+    ssd->dma_busy = false;
+    
+    if (ssd->dma_callback != NULL) {
+        ssd->dma_callback(ssd->dma_context);
+    }
+}
+#endif
+
+#ifdef SSD1331_USE_QUEUE
+//==============================================================================
+// ASYNCHRONOUS QUEUE FUNCTIONS
+//==============================================================================
+
+/**
+ * @brief Queue a callback that runs once all earlier packets were sent
+ * 
+ * The callback runs in interrupt context and must not draw.
+ * 
+ * @param ssd Pointer to SSD1331 driver structure
+ * @param callback Function to call from interrupt context
+ * @param context User pointer passed to the callback
+ * @return false if the packet was dropped (SSD1331_QUEUE_DROP only)
+ */
+bool SSD1331_QueueCallback(SSD1331_t *ssd, SSD1331_Callback_t callback, void *context) {
+    if (!SSD1331_Queue_Reserve(ssd, 1 + sizeof(callback) + sizeof(context), SSD1331_PKT_CALLBACK)) {
+        return false;
+    }
+    SSD1331_Queue_Put(&callback, sizeof(callback));
+    SSD1331_Queue_Put(&context, sizeof(context));
+    SSD1331_Queue_Commit();
+    return true;
+}
+
+/**
+ * @brief Check whether queued traffic is still being sent
+ * @param ssd Pointer to SSD1331 driver structure
+ * @return true while the queue owns the bus
+ */
+bool SSD1331_IsBusy(SSD1331_t *ssd) {
+    return ssd1331_q.active;
+}
+
+/**
+ * @brief Block until the queue is empty and the last byte has been sent
+ * @param ssd Pointer to SSD1331 driver structure
+ */
+void SSD1331_Flush(SSD1331_t *ssd) {
+    // Only SSD1331_InterruptHandler drains the queue
+    while (ssd1331_q.active);
+}
+
+/**
+ * @brief Queue command bytes (DC low)
+ * @param ssd Pointer to SSD1331 driver structure
+ * @param cmds Command bytes, copied into the queue
+ * @param n Number of bytes
+ */
+static void SSD1331_SendCommands(SSD1331_t *ssd, const uint8_t *cmds, uint8_t n) {
+    uint8_t len;
+    
+    while (n) {
+        len = (n > SSD1331_QUEUE_INLINE_MAX) ? SSD1331_QUEUE_INLINE_MAX : n;
+        if (!SSD1331_Queue_Reserve(ssd, 2 + len, SSD1331_PKT_CMD)) {
+            return;
+        }
+        SSD1331_Queue_Put(&len, 1);
+        SSD1331_Queue_Put(cmds, len);
+        SSD1331_Queue_Commit();
+        cmds += len;
+        n -= len;
+    }
+}
+
+/**
+ * @brief Queue a small block of data bytes (DC high)
+ * @param ssd Pointer to SSD1331 driver structure
+ * @param data Data bytes, copied into the queue
+ * @param n Number of bytes
+ */
+static void SSD1331_SendData(SSD1331_t *ssd, const uint8_t *data, uint8_t n) {
+    uint8_t len;
+    
+    while (n) {
+        len = (n > SSD1331_QUEUE_INLINE_MAX) ? SSD1331_QUEUE_INLINE_MAX : n;
+        if (!SSD1331_Queue_Reserve(ssd, 2 + len, SSD1331_PKT_DATA)) {
+            return;
+        }
+        SSD1331_Queue_Put(&len, 1);
+        SSD1331_Queue_Put(data, len);
+        SSD1331_Queue_Commit();
+        data += len;
+        n -= len;
+    }
+}
+
+/**
+ * @brief Queue a large block of data bytes by reference (DC high)
+ * @param ssd Pointer to SSD1331 driver structure
+ * @param data Data bytes, read from interrupt context until sent
+ * @param n Number of bytes
+ */
+static void SSD1331_SendDataRef(SSD1331_t *ssd, const uint8_t *data, uint16_t n) {
+    if (n == 0 || !SSD1331_Queue_Reserve(ssd, 3 + sizeof(data), SSD1331_PKT_DATA_REF)) {
+        return;
+    }
+    SSD1331_Queue_Put(&data, sizeof(data));
+    SSD1331_Queue_Put(&n, 2);
+    SSD1331_Queue_Commit();
+}
+
+/**
+ * @brief Queue one RGB565 color repeated for a number of pixels (DC high)
+ * @param ssd Pointer to SSD1331 driver structure
+ * @param color Color in RGB565 format
+ * @param count Number of pixels
+ */
+static void SSD1331_SendRepeat(SSD1331_t *ssd, uint16_t color, uint16_t count) {
+    uint8_t pattern[2] = { color >> 8, color & 0xFF };
+    
+    if (count == 0 || !SSD1331_Queue_Reserve(ssd, 5, SSD1331_PKT_REPEAT)) {
+        return;
+    }
+    SSD1331_Queue_Put(pattern, 2);
+    SSD1331_Queue_Put(&count, 2);
+    SSD1331_Queue_Commit();
+}
+
+/**
+ * @brief Queue NOP commands that keep the bus busy while the controller draws
+ * @param ssd Pointer to SSD1331 driver structure
+ * @param count Number of NOP command bytes
+ */
+static void SSD1331_SendPad(SSD1331_t *ssd, uint16_t count) {
+    if (count == 0 || !SSD1331_Queue_Reserve(ssd, 3, SSD1331_PKT_PAD)) {
+        return;
+    }
+    SSD1331_Queue_Put(&count, 2);
+    SSD1331_Queue_Commit();
+}
+
+/**
+ * @brief Free bytes in the ring buffer
+ * 
+ * One slot stays unused so that head == tail always means empty.
+ * 
+ * @return Bytes a packet may take without overwriting unsent data
+ */
+static uint8_t SSD1331_Queue_Room(void) {
+    uint8_t used = (uint8_t)(ssd1331_q.head - ssd1331_q.tail) & SSD1331_QUEUE_MASK;
+    
+    return (uint8_t)(SSD1331_QUEUE_MASK - used);
+}
+
+/**
+ * @brief Wait for room for a packet and start writing its header
+ * 
+ * Blocks until the interrupt handler has freed enough space, or with
+ * SSD1331_QUEUE_DROP counts the packet as dropped and gives up. After a
+ * drop the controller's write pointer is unknown, so pixel data is
+ * dropped as well until a command packet (normally the next address
+ * window) has been queued.
+ * 
+ * @param ssd Pointer to SSD1331 driver structure
+ * @param bytes Encoded packet size, including the type byte
+ * @param type Packet type
+ * @return false if the packet was dropped
+ */
+static bool SSD1331_Queue_Reserve(SSD1331_t *ssd, uint8_t bytes, uint8_t type) {
+#ifdef SSD1331_QUEUE_DROP
+    bool data = (type == SSD1331_PKT_DATA) || (type == SSD1331_PKT_DATA_REF) || (type == SSD1331_PKT_REPEAT);
+    
+    if ((data && ssd1331_q.resync) || (SSD1331_Queue_Room() < bytes)) {
+        ssd->queue_dropped++;
+        
+        // A lost window command leaves the cached window meaningless
+        ssd->win_valid = false;
+        ssd1331_q.resync = true;
+        return false;
+    }
+    if (type == SSD1331_PKT_CMD) {
+        ssd1331_q.resync = false;
+    }
+#else
+    while (SSD1331_Queue_Room() < bytes);
+#endif
+    
+    ssd1331_q.wr = ssd1331_q.head;
+    SSD1331_Queue_Put(&type, 1);
+    return true;
+}
+
+/**
+ * @brief Append bytes to the packet being written (not yet visible to the ISR)
+ * @param src Bytes to copy
+ * @param n Number of bytes
+ */
+static void SSD1331_Queue_Put(const void *src, uint8_t n) {
+    const uint8_t *p = src;
+    
+    while (n--) {
+        ssd1331_q_buf[ssd1331_q.wr] = *p++;
+        ssd1331_q.wr = (ssd1331_q.wr + 1) & SSD1331_QUEUE_MASK;
+    }
+}
+
+/**
+ * @brief Publish the packet being written and start draining if idle
+ */
+static void SSD1331_Queue_Commit(void) {
+    // A single byte store, so the ISR sees either none or all of the packet
+    ssd1331_q.head = ssd1331_q.wr;
+    
+    // 'active' is only cleared by the ISR once it has found the queue
+    // empty, so the new packet is either seen by it or restarted here
+    if (!ssd1331_q.active) {
+        ssd1331_q.active = true;
+        SSD1331_CS_SetLow();
+        SSD1331_SPI_BeginTx();
+        PIE2bits.SPI1TXIE = 1;
+    }
+}
+
+/**
+ * @brief Take bytes of the packet being sent out of the ring buffer
+ * @param dst Destination
+ * @param n Number of bytes
+ */
+static void SSD1331_Queue_Get(void *dst, uint8_t n) {
+    uint8_t *p = dst;
+    
+    while (n--) {
+        *p++ = ssd1331_q_buf[ssd1331_q.tail];
+        ssd1331_q.tail = (ssd1331_q.tail + 1) & SSD1331_QUEUE_MASK;
+    }
+}
+
+/**
+ * @brief Decode the next packet, or release the bus when the queue is empty
+ * 
+ * Called from the interrupt handler only, once SPI1 has sent every byte
+ * of the previous packet, so DC and chip select can change and a queued
+ * callback runs after everything before it is on the wire.
+ * 
+ * @return false when there was nothing left to send
+ */
+static bool SSD1331_Queue_Load(void) {
+    SSD1331_Callback_t callback;
+    void *context;
+    uint8_t len;
+    
+    if (ssd1331_q.tail == ssd1331_q.head) {
+        PIE2bits.SPI1TXIE = 0;
+        
+        // SPI1 has drained already: back to full duplex for SPI1_ExchangeByte users
+        SPI1CON2 = _SPI1CON2_SPI1RXR_MASK | _SPI1CON2_SPI1TXR_MASK;
+        SSD1331_CS_SetHigh();
+        ssd1331_q.active = false;
+        return false;
+    }
+    
+    SSD1331_Queue_Get(&ssd1331_q.type, 1);
+    ssd1331_q.burst = 0;
+    
+    switch (ssd1331_q.type) {
+        case SSD1331_PKT_CMD:
+            SSD1331_DC_SetLow();
+            SSD1331_Queue_Get(&len, 1);
+            ssd1331_q.remaining = len;
+            break;
+            
+        case SSD1331_PKT_DATA:
+            SSD1331_DC_SetHigh();
+            SSD1331_Queue_Get(&len, 1);
+            ssd1331_q.remaining = len;
+            break;
+            
+        case SSD1331_PKT_DATA_REF:
+            SSD1331_DC_SetHigh();
+            SSD1331_Queue_Get(&ssd1331_q.ref, sizeof(ssd1331_q.ref));
+            SSD1331_Queue_Get(&ssd1331_q.remaining, 2);
+            break;
+            
+        case SSD1331_PKT_REPEAT:
+            SSD1331_DC_SetHigh();
+            SSD1331_Queue_Get(ssd1331_q.pattern, 2);
+            SSD1331_Queue_Get(&ssd1331_q.remaining, 2);
+            ssd1331_q.remaining *= 2;
+            ssd1331_q.phase = 0;
+            break;
+            
+        case SSD1331_PKT_PAD:
+            // Sent like a REPEAT packet whose pattern is two NOPs
+            SSD1331_DC_SetLow();
+            SSD1331_Queue_Get(&ssd1331_q.remaining, 2);
+            ssd1331_q.pattern[0] = SSD1331_CMD_NOP;
+            ssd1331_q.pattern[1] = SSD1331_CMD_NOP;
+            ssd1331_q.phase = 0;
+            ssd1331_q.type = SSD1331_PKT_REPEAT;
+            break;
+            
+        case SSD1331_PKT_CALLBACK:
+            SSD1331_Queue_Get(&callback, sizeof(callback));
+            SSD1331_Queue_Get(&context, sizeof(context));
+            ssd1331_q.remaining = 0;
+            callback(context);
+            break;
+    }
+    return true;
+}
+
+/**
+ * @brief Keep the SPI1 transmit FIFO filled from the queue
+ * 
+ * Called from the interrupt handler only. Runs until the FIFO is full or
+ * the queue is empty. Between bursts SPI1 must be idle before SPI1TCNT,
+ * DC or chip select change; if it is still sending, SPI1TXIE is switched
+ * off and the shift register empty interrupt resumes the queue.
+ */
+static void SSD1331_Queue_Service(void) {
+    bool idle = false;
+    uint8_t b;
+    
+    while (PIR2bits.SPI1TXIF) {
+        if (ssd1331_q.burst == 0) {
+            // BUSY is checked once: nothing is sent until the next burst
+            if (!idle && !SSD1331_SPI_Drained()) {
+                PIE2bits.SPI1TXIE = 0;
+                return;
+            }
+            idle = true;
+            
+            if (ssd1331_q.remaining == 0) {
+                if (!SSD1331_Queue_Load()) {
+                    return;
+                }
+                continue;
+            }
+            
+            ssd1331_q.burst = (ssd1331_q.remaining > SSD1331_QUEUE_BURST) ? SSD1331_QUEUE_BURST : ssd1331_q.remaining;
+            SPI1TCNT = ssd1331_q.burst;
+            idle = false;
+        }
+        
+        switch (ssd1331_q.type) {
+            case SSD1331_PKT_DATA_REF:
+                b = *ssd1331_q.ref++;
+                break;
+                
+            case SSD1331_PKT_REPEAT:
+                b = ssd1331_q.pattern[ssd1331_q.phase];
+                ssd1331_q.phase ^= 1;
+                break;
+                
+            default:
+                SSD1331_Queue_Get(&b, 1);
+                break;
+        }
+        
+        SPI1TXB = b;
+        ssd1331_q.remaining--;
+        ssd1331_q.burst--;
+    }
+}
+#endif
+
+/**
+ * @brief Service driver interrupt sources
+ * 
+ * Advances the active DMA transfer once DMA1 has delivered its burst and
+ * SPI1 has sent it: starts the next burst or, after the last one,
+ * releases chip select and calls the completion callback. If SPI1 is
+ * still sending when DMA1 finishes, the shift register empty interrupt
+ * finishes the step instead of a busy wait. In queue mode, refills the
+ * SPI1 transmit FIFO from the draw queue, resuming on the shift register
+ * empty interrupt when a burst had to drain first.
+ */
+void SSD1331_InterruptHandler(void) {
+#ifdef SSD1331_USE_DMA
+    if (PIR2bits.DMA1DCNTIF) {
+        PIR2bits.DMA1DCNTIF = 0;
+        
+        if (ssd1331_dma.owner != NULL && SSD1331_SPI_Drained()) {
+            if (!SSD1331_DMA_Next()) {
+                SSD1331_DMA_Finish();
+            }
+        }
+    }
+    
+    // The last bytes of a burst have left the shift register
+    if (PIE2bits.SPI1IE && PIR2bits.SPI1IF) {
+        SPI1INTEbits.SRMTIE = 0;
+        SPI1INTFbits.SRMTIF = 0;
+        PIE2bits.SPI1IE = 0;
+        
+        if (!SSD1331_DMA_Next()) {
+            SSD1331_DMA_Finish();
+        }
+    }
+#endif
+#ifdef SSD1331_USE_QUEUE
+    // The previous burst has left the shift register: resume the queue
+    if (PIE2bits.SPI1IE && PIR2bits.SPI1IF) {
+        SPI1INTEbits.SRMTIE = 0;
+        SPI1INTFbits.SRMTIF = 0;
+        PIE2bits.SPI1IE = 0;
+        PIE2bits.SPI1TXIE = 1;
+    }
+    
+    if (PIE2bits.SPI1TXIE && PIR2bits.SPI1TXIF) {
+        SSD1331_Queue_Service();
+    }
+#endif
+}
+
+//==============================================================================
+// SPI COMMUNICATION FUNCTIONS
+//==============================================================================
+
+/**
+ * @brief Send command byte to SSD1331 via SPI
+ * 
+ * Sets command mode (DC low), selects chip, sends byte, then deselects.
+ * 
+ * @param ssd Pointer to SSD1331 driver structure
+ * @param cmd Command byte to send
+ */
+void SSD1331_WriteCommand(SSD1331_t *ssd, uint8_t cmd) {
+    SSD1331_SendCommands(ssd, &cmd, 1);
+    
+    // The command may have moved the address window
+    ssd->win_valid = false;
+}
+
+/**
+ * @brief Send a list of command bytes to SSD1331 via SPI
+ * 
+ * Sets command mode (DC low) and selects the chip once for the whole list,
+ * so a command and its arguments cost a single transaction.
+ * 
+ * @param ssd Pointer to SSD1331 driver structure
+ * @param cmds Command bytes, including command arguments
+ * @param n Number of bytes to send
+ */
+void SSD1331_WriteCommands(SSD1331_t *ssd, const uint8_t *cmds, uint8_t n) {
+    SSD1331_SendCommands(ssd, cmds, n);
+    
+    // The commands may have moved the address window
+    ssd->win_valid = false;
+}
+
+/**
+ * @brief Send 16-bit data word to SSD1331 via SPI
+ * 
+ * Sets data mode (DC high), selects chip, sends high byte then low byte,
+ * then deselects. Used for RGB565 pixel data.
+ * 
+ * @param ssd Pointer to SSD1331 driver structure
+ * @param data 16-bit data word to send (RGB565 pixel data)
+ */
+void SSD1331_WriteData16(SSD1331_t *ssd, uint16_t data) {
+    uint8_t buf[2] = { data >> 8, data & 0xFF };  // High byte, then low byte
+    SSD1331_SendData(ssd, buf, 2);
+    SSD1331_AdvanceWritePtr(ssd, 1);
+}
+
+/**
+ * @brief Write one RGB565 color repeatedly at the GDDRAM write pointer
+ * 
+ * Used as gfx.writeColor to stream runs into a window opened with
+ * SSD1331_SetAddrWindow.
+ * 
+ * @param ssd Pointer to SSD1331 driver structure
+ * @param color Pixel color in RGB565 format
+ * @param count Number of pixels
+ */
+void SSD1331_WriteColor(SSD1331_t *ssd, uint16_t color, uint16_t count) {
+    SSD1331_SendRepeat(ssd, color, count);
+    SSD1331_AdvanceWritePtr(ssd, count);
+}
+
+/**
+ * @brief Write RGB565 pixels at the GDDRAM write pointer
+ * 
+ * Pixels are swapped to big-endian a few at a time into a transmit-only
+ * burst. Used as gfx.writePixels.
+ * 
+ * @param ssd Pointer to SSD1331 driver structure
+ * @param colors Pixel colors in RGB565 format
+ * @param count Number of pixels
+ */
+void SSD1331_WritePixels(SSD1331_t *ssd, const uint16_t *colors, uint16_t count) {
+    uint8_t buf[SSD1331_SWAP_PIXELS * 2];
+    uint8_t n = 0;
+    
+    for (uint16_t p = 0; p < count; p++) {
+        buf[n++] = colors[p] >> 8;    // High byte (bits 15-8)
+        buf[n++] = colors[p] & 0xFF;  // Low byte (bits 7-0)
+        if (n == sizeof(buf)) {
+            SSD1331_SendData(ssd, buf, n);
+            n = 0;
+        }
+    }
+    if (n) {
+        SSD1331_SendData(ssd, buf, n);
+    }
+    SSD1331_AdvanceWritePtr(ssd, count);
+}
+
+/**
+ * @brief Write RGB888 pixels at the GDDRAM write pointer
+ * 
+ * Converts to RGB565 with 4x4 ordered dithering while packing the
+ * big-endian transmit bursts, so rows of true-color pixels need neither
+ * a conversion pass nor a buffer of their own.
+ * 
+ * @param ssd Pointer to SSD1331 driver structure
+ * @param rgb Pixels as R, G, B byte triples
+ * @param count Number of pixels
+ */
+void SSD1331_WriteRGB888(SSD1331_t *ssd, const uint8_t *rgb, uint16_t count) {
+    SSD1331_WriteRGB(ssd, rgb, rgb + 1, rgb + 2, 3, count);
+}
+
+/**
+ * @brief Write pixels given as separate 8-bit channel rows
+ * 
+ * Same conversion as SSD1331_WriteRGB888, for pixels held as one row of
+ * bytes per channel.
+ * 
+ * @param ssd Pointer to SSD1331 driver structure
+ * @param r Red channel (0-255 per pixel)
+ * @param g Green channel (0-255 per pixel)
+ * @param b Blue channel (0-255 per pixel)
+ * @param count Number of pixels
+ */
+void SSD1331_WriteRGBPlanes(SSD1331_t *ssd, const uint8_t *r, const uint8_t *g, const uint8_t *b, uint16_t count) {
+    SSD1331_WriteRGB(ssd, r, g, b, 1, count);
+}
+
+/**
+ * @brief Dither 8-bit channels to RGB565 and stream them as pixel data
+ * 
+ * Adds the GFX_Bayer threshold of each pixel's screen position to every
+ * channel before dropping the low bits, halved for the 3 bits red and
+ * blue lose and quartered for the 2 bits green loses, saturating at full
+ * scale. The
+ * position follows the cached write pointer through the window, so the
+ * pattern stays aligned across rows written by separate calls.
+ * 
+ * @param ssd Pointer to SSD1331 driver structure
+ * @param r First red byte
+ * @param g First green byte
+ * @param b First blue byte
+ * @param step Bytes from one pixel to the next in each channel
+ * @param count Number of pixels
+ */
+static void SSD1331_WriteRGB(SSD1331_t *ssd, const uint8_t *r, const uint8_t *g, const uint8_t *b,
+                             uint8_t step, uint16_t count) {
+    uint8_t buf[SSD1331_SWAP_PIXELS * 2];
+    uint8_t n = 0;
+    uint8_t x = ssd->win_valid ? ssd->wr_x : 0;
+    uint8_t y = ssd->win_valid ? ssd->wr_y : 0;
+    const uint8_t *bayer = GFX_Bayer[y & 3];
+    uint8_t t, r5, g6, b5;
+    uint16_t v;
+    
+    for (uint16_t p = 0; p < count; p++) {
+        t = bayer[x & 3];
+        v = *r + (t >> 1);
+        r5 = (v > 0xFF) ? 0x1F : (uint8_t)(v >> 3);
+        v = *g + (t >> 2);
+        g6 = (v > 0xFF) ? 0x3F : (uint8_t)(v >> 2);
+        v = *b + (t >> 1);
+        b5 = (v > 0xFF) ? 0x1F : (uint8_t)(v >> 3);
+        r += step;
+        g += step;
+        b += step;
+        
+        buf[n++] = (uint8_t)((r5 << 3) | (g6 >> 3));  // High byte: R4-0, G5-3
+        buf[n++] = (uint8_t)((g6 << 5) | b5);         // Low byte: G2-0, B4-0
+        if (n == sizeof(buf)) {
+            SSD1331_SendData(ssd, buf, n);
+            n = 0;
+        }
+        
+        if (ssd->win_valid && (x >= ssd->win_x1)) {
+            x = ssd->win_x0;
+            y = (y < ssd->win_y1) ? y + 1 : ssd->win_y0;
+            bayer = GFX_Bayer[y & 3];
+        } else {
+            x++;
+        }
+    }
+    if (n) {
+        SSD1331_SendData(ssd, buf, n);
+    }
+    SSD1331_AdvanceWritePtr(ssd, count);
+}
+
+#ifndef SSD1331_USE_QUEUE
+/**
+ * @brief Send command bytes in one transaction (DC low)
+ * @param ssd Pointer to SSD1331 driver structure
+ * @param cmds Command bytes
+ * @param n Number of bytes
+ */
+static void SSD1331_SendCommands(SSD1331_t *ssd, const uint8_t *cmds, uint8_t n) {
+    SSD1331_Select(ssd);
+    SSD1331_SetCommandMode(ssd);
+    SSD1331_SPI_WriteBlock(cmds, n);
+    SSD1331_Deselect(ssd);
+}
+
+/**
+ * @brief Send a small block of data bytes in one transaction (DC high)
+ * @param ssd Pointer to SSD1331 driver structure
+ * @param data Data bytes (may be reused as soon as the call returns)
+ * @param n Number of bytes
+ */
+static void SSD1331_SendData(SSD1331_t *ssd, const uint8_t *data, uint8_t n) {
+    SSD1331_Select(ssd);
+    SSD1331_SetDataMode(ssd);
+    SSD1331_SPI_WriteBlock(data, n);
+    SSD1331_Deselect(ssd);
+}
+
+/**
+ * @brief Send a large block of data bytes in one transaction (DC high)
+ * @param ssd Pointer to SSD1331 driver structure
+ * @param data Data bytes (must stay valid until they have been sent)
+ * @param n Number of bytes
+ */
+static void SSD1331_SendDataRef(SSD1331_t *ssd, const uint8_t *data, uint16_t n) {
+    SSD1331_Select(ssd);
+    SSD1331_SetDataMode(ssd);
+    SSD1331_SPI_WriteBlock(data, n);
+    SSD1331_Deselect(ssd);
+}
+
+/**
+ * @brief Send one RGB565 color repeatedly in one transaction (DC high)
+ * @param ssd Pointer to SSD1331 driver structure
+ * @param color Color in RGB565 format
+ * @param count Number of pixels
+ */
+static void SSD1331_SendRepeat(SSD1331_t *ssd, uint16_t color, uint16_t count) {
+    uint8_t pattern[2] = { color >> 8, color & 0xFF };
+    
+    SSD1331_Select(ssd);
+    SSD1331_SetDataMode(ssd);
+    SSD1331_SPI_WriteRepeat(pattern, 2, count);
+    SSD1331_Deselect(ssd);
+}
+#endif
+
+//==============================================================================
+// TRANSMIT-ONLY SPI1 FUNCTIONS
+//==============================================================================
+
+/*
+ * The SSD1331 never drives MISO, so SPI1 runs with the receiver disabled:
+ * nothing is read back and transfers are paced by the TX FIFO alone. These
+ * live here rather than in the MCC SPI1 driver so that regenerating it
+ * does not remove them.
+ */
+
+/**
+ * @brief Switch SPI1 to transmit-only mode
+ * 
+ * Received bytes are discarded. Each transfer must load SPI1TCNT with
+ * the number of bytes it sends.
+ */
+static void SSD1331_SPI_BeginTx(void) {
+    SPI1CON2 = _SPI1CON2_SPI1TXR_MASK;
+}
+
+#if defined(SSD1331_USE_DMA) || defined(SSD1331_USE_QUEUE)
+/**
+ * @brief Check from interrupt context whether SPI1 has sent every byte
+ * 
+ * When bytes are still pending, enables the shift register empty
+ * interrupt instead of waiting, so SSD1331_InterruptHandler() runs again
+ * once they are out.
+ * 
+ * @return true when SPI1 is idle
+ */
+static bool SSD1331_SPI_Drained(void) {
+    // Cleared first, so an SRMT event after this point still raises SPI1IF
+    SPI1INTFbits.SRMTIF = 0;
+    if (!SPI1CON2bits.BUSY) {
+        return true;
+    }
+    SPI1INTEbits.SRMTIE = 1;
+    PIE2bits.SPI1IE = 1;
+    return false;
+}
+#endif
+
+#ifndef SSD1331_USE_QUEUE
+/**
+ * @brief Return SPI1 to full duplex once the last byte has left
+ * 
+ * Waits for the shift register to empty, so chip select and data/command
+ * can change safely afterwards.
+ */
+static void SSD1331_SPI_EndTx(void) {
+    while (SPI1CON2bits.BUSY);
+    SPI1CON2 = _SPI1CON2_SPI1RXR_MASK | _SPI1CON2_SPI1TXR_MASK;
+}
+
+/**
+ * @brief Send a block of bytes, one SPI1TCNT load per burst
+ * @param data Bytes to send
+ * @param n Number of bytes
+ */
+static void SSD1331_SPI_WriteBlock(const uint8_t *data, uint16_t n) {
+    uint16_t burst;
+    
+    SSD1331_SPI_BeginTx();
+    while (n) {
+        burst = (n > SSD1331_SPI_TCNT_MAX) ? SSD1331_SPI_TCNT_MAX : n;
+        n -= burst;
+        
+        // Reloading SPI1TCNT while bytes are pending replaces their count
+        while (SPI1CON2bits.BUSY);
+        SPI1TCNT = burst;
+        while (burst--) {
+            while (!PIR2bits.SPI1TXIF);
+            SPI1TXB = *data++;
+        }
+    }
+    SSD1331_SPI_EndTx();
+}
+
+/**
+ * @brief Send a short byte pattern repeatedly
+ * @param pattern Pattern bytes
+ * @param size Bytes in the pattern
+ * @param count Number of times the pattern is sent
+ */
+static void SSD1331_SPI_WriteRepeat(const uint8_t *pattern, uint8_t size, uint16_t count) {
+    uint32_t total = (uint32_t)size * count;
+    uint16_t burst;
+    uint8_t i = 0;
+    
+    if (size == 0) {
+        return;
+    }
+    SSD1331_SPI_BeginTx();
+    while (total) {
+        burst = (total > SSD1331_SPI_TCNT_MAX) ? SSD1331_SPI_TCNT_MAX : (uint16_t)total;
+        total -= burst;
+        
+        // Reloading SPI1TCNT while bytes are pending replaces their count
+        while (SPI1CON2bits.BUSY);
+        SPI1TCNT = burst;
+        while (burst--) {
+            while (!PIR2bits.SPI1TXIF);
+            SPI1TXB = pattern[i];
+            if (++i == size) {
+                i = 0;
+            }
+        }
+    }
+    SSD1331_SPI_EndTx();
+}
+#endif
+
+//==============================================================================
+// PRIVATE HELPER FUNCTIONS
+//==============================================================================
+
+/**
+ * @brief Perform hardware reset sequence on SSD1331
+ * 
+ * Toggles reset pin with appropriate delays to reset the display controller.
+ * 
+ * @param ssd Pointer to SSD1331 driver structure
+ */
+static void SSD1331_HardwareReset(SSD1331_t *ssd) {
+    SSD1331_RST_SetHigh();  // Ensure reset is inactive
+    SSD1331_Delay(10);      // Wait for stability
+    SSD1331_RST_SetLow();   // Assert reset
+    SSD1331_Delay(10);      // Hold reset active
+    SSD1331_RST_SetHigh();  // Release reset
+    SSD1331_Delay(10);      // Wait for controller to initialize
+}
+
+#ifndef SSD1331_USE_QUEUE
+/**
+ * @brief Assert chip select (select SSD1331 for communication)
+ * @param ssd Pointer to SSD1331 driver structure
+ */
+static void SSD1331_Select(SSD1331_t *ssd) { 
+#ifdef SSD1331_USE_DMA
+    SSD1331_DMA_Wait();
+#endif
+    SSD1331_CS_SetLow(); 
+}
+
+/**
+ * @brief Deassert chip select (end communication with SSD1331)
+ * @param ssd Pointer to SSD1331 driver structure
+ */
+static void SSD1331_Deselect(SSD1331_t *ssd) { 
+    SSD1331_CS_SetHigh(); 
+}
+
+/**
+ * @brief Set data mode (DC high for data transmission)
+ * @param ssd Pointer to SSD1331 driver structure
+ */
+static void SSD1331_SetDataMode(SSD1331_t *ssd) { 
+    SSD1331_DC_SetHigh(); 
+}
+
+/**
+ * @brief Set command mode (DC low for command transmission)
+ * @param ssd Pointer to SSD1331 driver structure
+ */
+static void SSD1331_SetCommandMode(SSD1331_t *ssd) { 
+    SSD1331_DC_SetLow(); 
+}
+#endif
+
+/**
+ * @brief Track GDDRAM auto-increment after pixels were written
+ * 
+ * Moves the cached write pointer through the cached window the same way
+ * the controller does: along the row, then to the next row, wrapping back
+ * to the window origin after the last pixel.
+ * 
+ * @param ssd Pointer to SSD1331 driver structure
+ * @param pixels Number of pixels written
+ */
+static void SSD1331_AdvanceWritePtr(SSD1331_t *ssd, uint16_t pixels) {
+    if (!ssd->win_valid) {
+        return;
+    }
+    
+    // Single pixels are the common case (DrawPixel), avoid the divisions
+    if (pixels == 1) {
+        if (ssd->wr_x < ssd->win_x1) {
+            ssd->wr_x++;
+        } else {
+            ssd->wr_x = ssd->win_x0;
+            ssd->wr_y = (ssd->wr_y < ssd->win_y1) ? ssd->wr_y + 1 : ssd->win_y0;
+        }
+        return;
+    }
+    
+    uint8_t w = ssd->win_x1 - ssd->win_x0 + 1;
+    uint16_t area = (uint16_t)w * (uint8_t)(ssd->win_y1 - ssd->win_y0 + 1);
+    uint16_t pos = (uint16_t)(ssd->wr_y - ssd->win_y0) * w + (ssd->wr_x - ssd->win_x0);
+    
+    pos = (pos + pixels % area) % area;
+    ssd->wr_x = ssd->win_x0 + (uint8_t)(pos % w);
+    ssd->wr_y = ssd->win_y0 + (uint8_t)(pos / w);
+}
+
+/**
+ * @brief Clip a rectangle to the display's GFX clip rectangle
+ * @param ssd Pointer to SSD1331 driver structure
+ * @param x X coordinate of top-left corner (updated)
+ * @param y Y coordinate of top-left corner (updated)
+ * @param w Rectangle width in pixels (updated)
+ * @param h Rectangle height in pixels (updated)
+ * @return false if nothing of the rectangle is visible
+ */
+static bool SSD1331_ClipRect(SSD1331_t *ssd, int16_t *x, int16_t *y, int16_t *w, int16_t *h) {
+    return GFX_ClipRect(&ssd->gfx, x, y, w, h);
+}
+
+/**
+ * @brief Write two points as GDDRAM column/row pairs for drawing commands
+ * 
+ * Same mapping as SSD1331_SetAddrWindow: rotations 1 and 3 swap the
+ * logical axes, the re-map register takes care of the directions.
+ * 
+ * @param ssd Pointer to SSD1331 driver structure
+ * @param dst Destination for column0, row0, column1, row1
+ * @param x0 X coordinate of first point
+ * @param y0 Y coordinate of first point
+ * @param x1 X coordinate of second point
+ * @param y1 Y coordinate of second point
+ */
+static void SSD1331_PutRAMCoords(SSD1331_t *ssd, uint8_t *dst, int16_t x0, int16_t y0, int16_t x1, int16_t y1) {
+    if (ssd->rotation == 0 || ssd->rotation == 2) {
+        dst[0] = (uint8_t)x0;
+        dst[1] = (uint8_t)y0;
+        dst[2] = (uint8_t)x1;
+        dst[3] = (uint8_t)y1;
+    } else {
+        dst[0] = (uint8_t)y0;
+        dst[1] = (uint8_t)x0;
+        dst[2] = (uint8_t)y1;
+        dst[3] = (uint8_t)x1;
+    }
+}
+
+/**
+ * @brief Write an RGB565 color as the 3 x 6-bit form drawing commands use
+ * @param dst Destination for color C, B, A
+ * @param color Color in RGB565 format
+ */
+static void SSD1331_PutColor(uint8_t *dst, uint16_t color) {
+    dst[0] = (uint8_t)((color >> 11) << 1);
+    dst[1] = (uint8_t)((color >> 5) & 0x3F);
+    dst[2] = (uint8_t)((color << 1) & 0x3F);
+}
+
+/**
+ * @brief Give the drawing engine time to finish before the next command
+ * 
+ * In queue mode the command may not have been sent yet, so the bus is
+ * padded with NOP commands instead.
+ * 
+ * @param ssd Pointer to SSD1331 driver structure
+ * @param us Wait for this kind of command
+ */
+static void SSD1331_HardwareWait(SSD1331_t *ssd, uint16_t us) {
+#ifdef SSD1331_USE_QUEUE
+    SSD1331_SendPad(ssd, us * SSD1331_QUEUE_PAD_PER_US);
+#else
+    while (us--) {
+        __delay_us(1);
+    }
+#endif
 }
\ No newline at end of file
@@ -34,6 +34,70 @@
 #error "RGB and BGR can not both be defined for SSD1331_COLORORDER."
 #endif
 
+//==============================================================================
+// DMA STREAMING CONFIGURATION
+//==============================================================================
+
+/**
+ * @brief Enable DMA-driven pixel streaming (DMA1 -> SPI1TXB)
+ *
+ * When defined, SSD1331_FillScreen, SSD1331_FillRect_Fast and the
+ * SSD1331_DrawFastRGBBitmap functions arm DMA1 and return immediately.
+ * Bitmaps are read while they are sent, so the caller must not change or
+ * release one until SSD1331_IsBusy() returns false. The transfer is
+ * advanced by SSD1331_InterruptHandler(), which must be
+ * called from the application's interrupt routine. Global interrupts must
+ * be enabled before SSD1331_Begin(); nothing advances a transfer without
+ * them.
+ */
+// #define SSD1331_USE_DMA
+
+/** @brief Maximum bytes per DMA/SPI burst (SPI1TCNT is 11 bits wide) */
+#define SSD1331_DMA_CHUNK     2046
+
+/** @brief DMA start trigger source: SPI1 transmit interrupt (SPI1TXIF) */
+#define SSD1331_DMA_SPI1TX_IRQ 0x15
+
+//==============================================================================
+// ASYNCHRONOUS QUEUE CONFIGURATION
+//==============================================================================
+
+/**
+ * @brief Enable the interrupt-driven draw queue
+ *
+ * When defined, every SSD1331_* and GFX_* drawing call encodes its
+ * command and pixel traffic into a ring buffer and returns. The buffer
+ * is drained by SSD1331_InterruptHandler() on SPI1TXIF, which must be
+ * called from the application's interrupt routine and is the only place
+ * the queue is drained. Global interrupts must be enabled before
+ * SSD1331_Begin(). Use SSD1331_Flush() to wait until everything queued
+ * has reached the display. Queued callbacks run in interrupt context.
+ */
+// #define SSD1331_USE_QUEUE
+
+/** @brief Ring buffer size in bytes (power of two, at most 256) */
+#define SSD1331_QUEUE_SIZE    256
+
+/**
+ * @brief Drop packets instead of waiting when the queue is full
+ *
+ * By default a full queue blocks the caller until the interrupt handler
+ * has made room. With this defined the packet is discarded and counted
+ * in queue_dropped, which leaves the frame incomplete but never stalls
+ * the caller. Pixel data is then discarded too until the next address
+ * window has been queued, so nothing is drawn in the wrong place.
+ */
+// #define SSD1331_QUEUE_DROP
+
+#if defined(SSD1331_USE_QUEUE) && defined(SSD1331_USE_DMA)
+#error "SSD1331_USE_QUEUE and SSD1331_USE_DMA both own SPI1 and cannot be combined"
+#endif
+
+#if defined(SSD1331_USE_QUEUE) && \
+    ((SSD1331_QUEUE_SIZE > 256) || (SSD1331_QUEUE_SIZE & (SSD1331_QUEUE_SIZE - 1)))
+#error "SSD1331_QUEUE_SIZE must be a power of two no larger than 256"
+#endif
+
 //==============================================================================
 // DISPLAY SPECIFICATIONS
 //==============================================================================
@@ -111,21 +175,84 @@
 #define SSD1331_CMD_PRECHARGEC      0x8C  ///< Set second pre-charge speed for color C
 #define SSD1331_CMD_PRECHARGELEVEL  0xBB  ///< Set pre-charge voltage level
 #define SSD1331_CMD_VCOMH           0xBE  ///< Set VCOMH voltage
+#define SSD1331_CMD_NOP             0xE3  ///< No operation
 
 //==============================================================================
 // TIMING DELAYS
 //==============================================================================
 
-/** @brief Delay after hardware fill operations (3ms recommended) */
-#define SSD1331_DELAY_HWFILL()      __delay_ms(3)
+/**
+ * @brief Wait after a hardware line command (us)
+ *
+ * The recommended 1 ms. The datasheet gives no drawing rate for the
+ * graphic acceleration commands, so only lower this (for instance with
+ * -DSSD1331_HW_LINE_MIN_US=...) for a panel on which the engine has been
+ * timed.
+ */
+#ifndef SSD1331_HW_LINE_MIN_US
+#define SSD1331_HW_LINE_MIN_US      1000
+#endif
+
+/**
+ * @brief Wait after a hardware rectangle, copy or clear command (us)
+ *
+ * The recommended 3 ms, whatever the area. Without a measured engine
+ * rate an area-based wait cannot be trusted to be long enough, so the
+ * area only decides whether a fill goes to the engine at all (see
+ * SSD1331_HW_AREA_MIN). Like SSD1331_HW_LINE_MIN_US, it may be lowered
+ * for a timed panel.
+ */
+#ifndef SSD1331_HW_FILL_MIN_US
+#define SSD1331_HW_FILL_MIN_US      3000
+#endif
+
+/** @brief Smallest rectangle area filled by the engine instead of being streamed (pixels) */
+#define SSD1331_HW_AREA_MIN         (SSD1331_HW_FILL_MIN_US / 2)
 
-/** @brief Delay after hardware line operations (1ms recommended) */
-#define SSD1331_DELAY_HWLINE()      __delay_ms(1)
+/**
+ * @brief Smallest outline drawn by the engine instead of as four spans (pixels)
+ *
+ * Counts 2 * (w + h). The largest outline on the panel is 320 pixels,
+ * so with the recommended rectangle wait every outline is streamed; the
+ * engine only draws outlines once SSD1331_HW_FILL_MIN_US is 640 or less.
+ */
+#define SSD1331_HW_OUTLINE_MIN      (SSD1331_HW_FILL_MIN_US / 2)
 
 //==============================================================================
 // DATA STRUCTURES
 //==============================================================================
 
+/**
+ * @brief Completion callback for asynchronous transfers
+ * @param context User pointer registered together with the callback
+ */
+typedef void (*SSD1331_Callback_t)(void *context);
+
+/**
+ * @brief Renders one line for SSD1331_DrawScanlines
+ * @param context User pointer passed to SSD1331_DrawScanlines
+ * @param row Y coordinate of the line
+ * @param line Buffer for w RGB565 pixels, high byte first
+ * @param w Number of pixels in the line
+ */
+typedef void (*SSD1331_ScanlineFill_t)(void *context, int16_t row, uint8_t *line, int16_t w);
+
+/**
+ * @brief Overlap statistics reported by SSD1331_DrawScanlines
+ */
+typedef struct {
+    uint8_t lines;      ///< Lines rendered
+    uint8_t overlapped; ///< Lines rendered while the previous line was still being sent
+} SSD1331_ScanlineStats_t;
+
+/**
+ * @brief Memory region a DMA source pointer lives in
+ */
+typedef enum {
+    SSD1331_DMA_SRC_RAM   = 0, ///< Data memory (GPR/SFR space)
+    SSD1331_DMA_SRC_FLASH = 1  ///< Program flash memory (const tables)
+} SSD1331_DMASource_t;
+
 /**
  * @brief SSD1331 OLED driver structure
  * 
@@ -135,6 +262,21 @@
 typedef struct {
     GFX_t gfx;        ///< Inherited graphics context from GFX library
     uint8_t rotation; ///< Current display rotation (0-3: 0, 90, 180, 270)
+    bool win_valid;   ///< True while win_* and wr_* match the controller state
+    uint8_t win_x0;   ///< Cached address window, left column (logical)
+    uint8_t win_y0;   ///< Cached address window, top row (logical)
+    uint8_t win_x1;   ///< Cached address window, right column (logical)
+    uint8_t win_y1;   ///< Cached address window, bottom row (logical)
+    uint8_t wr_x;     ///< Column the next pixel will be written to (logical)
+    uint8_t wr_y;     ///< Row the next pixel will be written to (logical)
+#ifdef SSD1331_USE_DMA
+    volatile bool dma_busy;          ///< True while a DMA transfer owns the bus
+    SSD1331_Callback_t dma_callback; ///< Called from the ISR when a transfer completes
+    void *dma_context;               ///< User pointer passed to dma_callback
+#endif
+#ifdef SSD1331_USE_QUEUE
+    uint16_t queue_dropped;          ///< Packets discarded because the queue was full
+#endif
 } SSD1331_t;
 
 //==============================================================================
@@ -187,8 +329,32 @@ void SSD1331_DrawPixel(SSD1331_t *ssd, int16_t x, int16_t y, uint16_t color);
  */
 void SSD1331_FillScreen(SSD1331_t *ssd, uint16_t color);
 
+/**
+ * @brief Draw a horizontal span streamed through a one-row window
+ * @param ssd Pointer to SSD1331 driver structure
+ * @param x Starting X coordinate
+ * @param y Y coordinate of the span
+ * @param w Span length in pixels
+ * @param color Span color in RGB565 format
+ */
+void SSD1331_DrawFastHLine(SSD1331_t *ssd, int16_t x, int16_t y, int16_t w, uint16_t color);
+
+/**
+ * @brief Draw a vertical span streamed through a one-column window
+ * @param ssd Pointer to SSD1331 driver structure
+ * @param x X coordinate of the span
+ * @param y Starting Y coordinate
+ * @param h Span length in pixels
+ * @param color Span color in RGB565 format
+ */
+void SSD1331_DrawFastVLine(SSD1331_t *ssd, int16_t x, int16_t y, int16_t h, uint16_t color);
+
 /**
  * @brief Draw a line between two points using hardware acceleration
+ * 
+ * Lines that stream faster than the engine's SSD1331_HW_LINE_MIN_US wait
+ * are drawn by GFX_WriteLine instead.
+ * 
  * @param ssd Pointer to SSD1331 driver structure
  * @param x0 X coordinate of start point
  * @param y0 Y coordinate of start point
@@ -200,6 +366,10 @@ void SSD1331_DrawLine(SSD1331_t *ssd, int16_t x0, int16_t y0, int16_t x1, int16_
 
 /**
  * @brief Draw rectangle outline using hardware acceleration
+ * 
+ * Outlines under SSD1331_HW_OUTLINE_MIN pixels, which with the
+ * recommended waits is all of them, are drawn as four spans instead.
+ * 
  * @param ssd Pointer to SSD1331 driver structure
  * @param x X coordinate of top-left corner
  * @param y Y coordinate of top-left corner
@@ -255,6 +425,10 @@ void SSD1331_FillRect_Fast(SSD1331_t *ssd, int16_t x, int16_t y, int16_t w, int1
  * @note The bitmap data should be organized row by row, left to right
  * @note Total array size should be w * h uint16_t elements
  * @note Function validates input parameters and returns early if invalid
+ * @note With SSD1331_USE_DMA the function returns once the transfer has
+ *       started, and the interrupt handler keeps reading rows from bitmap.
+ *       Leave the bitmap unchanged (and in scope) until SSD1331_IsBusy()
+ *       returns false, or call SSD1331_WaitDMA() before reusing it.
  * */
 void SSD1331_DrawFastRGBBitmap16(SSD1331_t *ssd, int16_t x, int16_t y, const uint16_t *bitmap, int16_t w, int16_t h);
 
@@ -281,9 +455,136 @@ void SSD1331_DrawFastRGBBitmap16(SSD1331_t *ssd, int16_t x, int16_t y, const uin
  * @note Data format: [pixel0_high, pixel0_low, pixel1_high, pixel1_low, ...]
  * @note This function assumes the byte data is already in correct RGB565 format
  * @note Uses SPI block transfer for optimal performance
+ * @note With SSD1331_USE_DMA the function returns once the transfer has
+ *       started, and the interrupt handler keeps reading rows from bitmap.
+ *       Leave the bitmap unchanged (and in scope) until SSD1331_IsBusy()
+ *       returns false, or call SSD1331_WaitDMA() before reusing it.
+ * @note With SSD1331_USE_QUEUE the pixels are copied into the queue, so
+ *       the bitmap may be reused as soon as the function returns.
  */
 void SSD1331_DrawFastRGBBitmap8(SSD1331_t *ssd, int16_t x, int16_t y, const uint8_t *bitmap, int16_t w, int16_t h);
 
+//==============================================================================
+// SCANLINE PIPELINE FUNCTIONS
+//==============================================================================
+
+/**
+ * @brief Draw a software-rendered area one line at a time
+ *
+ * The fill callback renders line N+1 into one RAM line buffer while line
+ * N is sent from the other by DMA or the SPI queue interrupt. Compare
+ * stats->overlapped with stats->lines to see how much rendering was
+ * hidden behind bus time.
+ *
+ * @param ssd Pointer to SSD1331 driver structure
+ * @param x X coordinate of top-left corner
+ * @param y Y coordinate of top-left corner
+ * @param w Area width in pixels (at most SSD1331_WIDTH)
+ * @param h Area height in pixels
+ * @param fill Callback that renders one line
+ * @param context User pointer passed to the callback
+ * @param stats Optional overlap statistics (NULL if not needed)
+ */
+void SSD1331_DrawScanlines(SSD1331_t *ssd, int16_t x, int16_t y, int16_t w, int16_t h,
+                           SSD1331_ScanlineFill_t fill, void *context, SSD1331_ScanlineStats_t *stats);
+
+#ifdef SSD1331_USE_DMA
+//==============================================================================
+// DMA STREAMING FUNCTIONS
+//==============================================================================
+
+/**
+ * @brief Stream a raw RGB565 byte bitmap straight from memory with DMA1
+ *
+ * Unlike SSD1331_DrawFastRGBBitmap8, the data is not copied through a
+ * line buffer: DMA1 reads the source directly and feeds SPI1TXB. The
+ * caller must state which memory region the bitmap lives in and keep it
+ * valid until the transfer completes.
+ *
+ * @param ssd Pointer to SSD1331 driver structure
+ * @param x Starting X coordinate for bitmap placement (top-left corner)
+ * @param y Starting Y coordinate for bitmap placement (top-left corner)
+ * @param bitmap Pointer to raw RGB565 byte data (2 bytes per pixel)
+ * @param w Bitmap width in pixels
+ * @param h Bitmap height in pixels
+ * @param source Memory region of bitmap (RAM or program flash)
+ */
+void SSD1331_DrawFastRGBBitmap8_DMA(SSD1331_t *ssd, int16_t x, int16_t y, const uint8_t *bitmap, int16_t w, int16_t h, SSD1331_DMASource_t source);
+
+/**
+ * @brief Register the callback invoked when a DMA transfer completes
+ *
+ * The callback runs inside SSD1331_InterruptHandler(), so it must be short
+ * and must not draw.
+ *
+ * @param ssd Pointer to SSD1331 driver structure
+ * @param callback Function to call from interrupt context (NULL to disable)
+ * @param context User pointer passed to the callback
+ */
+void SSD1331_SetDMACallback(SSD1331_t *ssd, SSD1331_Callback_t callback, void *context);
+
+/**
+ * @brief Check whether a DMA transfer is still in progress
+ * @param ssd Pointer to SSD1331 driver structure
+ * @return true while the bus is owned by DMA
+ */
+bool SSD1331_IsBusy(SSD1331_t *ssd);
+
+/**
+ * @brief Block until the current DMA transfer has completed
+ *
+ * Never returns while a transfer is active and global interrupts are
+ * disabled.
+ *
+ * @param ssd Pointer to SSD1331 driver structure
+ */
+void SSD1331_WaitDMA(SSD1331_t *ssd);
+#endif
+
+#ifdef SSD1331_USE_QUEUE
+//==============================================================================
+// ASYNCHRONOUS QUEUE FUNCTIONS
+//==============================================================================
+
+/**
+ * @brief Queue a callback that runs once all earlier packets were sent
+ *
+ * The callback runs inside SSD1331_InterruptHandler(), so it must be short
+ * and must not draw.
+ *
+ * @param ssd Pointer to SSD1331 driver structure
+ * @param callback Function to call from interrupt context
+ * @param context User pointer passed to the callback
+ * @return false if the packet was dropped (SSD1331_QUEUE_DROP only)
+ */
+bool SSD1331_QueueCallback(SSD1331_t *ssd, SSD1331_Callback_t callback, void *context);
+
+/**
+ * @brief Check whether queued traffic is still being sent
+ * @param ssd Pointer to SSD1331 driver structure
+ * @return true while the queue owns the bus
+ */
+bool SSD1331_IsBusy(SSD1331_t *ssd);
+
+/**
+ * @brief Block until the queue is empty and the last byte has been sent
+ *
+ * Never returns while the queue holds data and global interrupts are
+ * disabled. Must not be called from interrupt context.
+ *
+ * @param ssd Pointer to SSD1331 driver structure
+ */
+void SSD1331_Flush(SSD1331_t *ssd);
+#endif
+
+/**
+ * @brief Service driver interrupt sources
+ *
+ * Call from the application's interrupt routine. Does nothing when no
+ * interrupt-driven mode is enabled.
+ */
+void SSD1331_InterruptHandler(void);
+
 //==============================================================================
 // ADDRESS WINDOW CONFIGURATION
 //==============================================================================
@@ -309,6 +610,14 @@ void SSD1331_SetAddrWindow(SSD1331_t *ssd, uint16_t x, uint16_t y, uint16_t w, u
  */
 void SSD1331_WriteCommand(SSD1331_t *ssd, uint8_t cmd);
 
+/**
+ * @brief Send a list of command bytes in a single SPI transaction
+ * @param ssd Pointer to SSD1331 driver structure
+ * @param cmds Command bytes, including command arguments
+ * @param n Number of bytes to send
+ */
+void SSD1331_WriteCommands(SSD1331_t *ssd, const uint8_t *cmds, uint8_t n);
+
 /**
  * @brief Send data byte to SSD1331 via SPI
  * @param ssd Pointer to SSD1331 driver structure
@@ -323,6 +632,45 @@ void SSD1331_WriteData(SSD1331_t *ssd, uint8_t data);
  */
 void SSD1331_WriteData16(SSD1331_t *ssd, uint16_t data);
 
+/**
+ * @brief Write one RGB565 color repeatedly at the GDDRAM write pointer
+ * @param ssd Pointer to SSD1331 driver structure
+ * @param color Pixel color in RGB565 format
+ * @param count Number of pixels
+ */
+void SSD1331_WriteColor(SSD1331_t *ssd, uint16_t color, uint16_t count);
+
+/**
+ * @brief Write RGB565 pixels at the GDDRAM write pointer
+ * @param ssd Pointer to SSD1331 driver structure
+ * @param colors Pixel colors in RGB565 format
+ * @param count Number of pixels
+ */
+void SSD1331_WritePixels(SSD1331_t *ssd, const uint16_t *colors, uint16_t count);
+
+/**
+ * @brief Write RGB888 pixels at the GDDRAM write pointer
+ * 
+ * Each pixel is converted to RGB565 with 4x4 ordered dithering as it is
+ * packed for transmission. Open the window with SSD1331_SetAddrWindow,
+ * then write it row by row.
+ * 
+ * @param ssd Pointer to SSD1331 driver structure
+ * @param rgb Pixels as R, G, B byte triples
+ * @param count Number of pixels
+ */
+void SSD1331_WriteRGB888(SSD1331_t *ssd, const uint8_t *rgb, uint16_t count);
+
+/**
+ * @brief Write pixels given as separate 8-bit channel rows
+ * @param ssd Pointer to SSD1331 driver structure
+ * @param r Red channel (0-255 per pixel)
+ * @param g Green channel (0-255 per pixel)
+ * @param b Blue channel (0-255 per pixel)
+ * @param count Number of pixels
+ */
+void SSD1331_WriteRGBPlanes(SSD1331_t *ssd, const uint8_t *r, const uint8_t *g, const uint8_t *b, uint16_t count);
+
 //==============================================================================
 // CONTRAST CONTROL FUNCTIONS
 //==============================================================================
@@ -398,6 +746,18 @@ void SSD1331_SetupScroll(SSD1331_t *ssd, uint8_t startRow, uint8_t endRow, uint8
  */
 void SSD1331_CopyArea(SSD1331_t *ssd, uint8_t x0, uint8_t y0, uint8_t x1, uint8_t y1, uint8_t x2, uint8_t y2);
 
+/**
+ * @brief Copy a rectangle given by position and size, clipped to the screen
+ * @param ssd Pointer to SSD1331 driver structure
+ * @param x Source top-left X coordinate
+ * @param y Source top-left Y coordinate
+ * @param w Width in pixels
+ * @param h Height in pixels
+ * @param x2 Destination top-left X coordinate
+ * @param y2 Destination top-left Y coordinate
+ */
+void SSD1331_CopyRect(SSD1331_t *ssd, int16_t x, int16_t y, int16_t w, int16_t h, int16_t x2, int16_t y2);
+
 /**
  * @brief Dim (reduce brightness of) specified window area
  * @param ssd Pointer to SSD1331 driver structure
@@ -0,0 +1,110 @@
+/**
+ * @file canvas.c
+ * @brief GFX_t whose hooks draw into memory, for checking rasterisers
+ *
+ * @author @btondin
+ * @date 2025
+ */
+
+#include "canvas.h"
+#include "harness.h"
+#include <string.h>
+
+/** @brief Differing cases canvas_compare prints */
+#define CANVAS_SHOW_DIFFER  5
+
+uint16_t canvas[CANVAS_H][CANVAS_W];
+uint8_t canvas_hits[CANVAS_H][CANVAS_W];
+unsigned long canvas_calls;
+unsigned long canvas_outside;
+
+static void canvas_put(int16_t x, int16_t y, uint16_t color) {
+    if (x < 0 || y < 0 || x >= CANVAS_W || y >= CANVAS_H) {
+        canvas_outside++;
+        return;
+    }
+    canvas[y][x] = color;
+    canvas_hits[y][x]++;
+}
+
+static void canvas_fill(void *display, int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {
+    int16_t i, j;
+
+    (void)display;
+    canvas_calls++;
+    for (j = 0; j < h; j++) {
+        for (i = 0; i < w; i++) {
+            canvas_put((int16_t)(x + i), (int16_t)(y + j), color);
+        }
+    }
+}
+
+static void canvas_pixel(void *display, int16_t x, int16_t y, uint16_t color) {
+    canvas_fill(display, x, y, 1, 1, color);
+}
+
+static void canvas_hline(void *display, int16_t x, int16_t y, int16_t w, uint16_t color) {
+    canvas_fill(display, x, y, w, 1, color);
+}
+
+static void canvas_vline(void *display, int16_t x, int16_t y, int16_t h, uint16_t color) {
+    canvas_fill(display, x, y, 1, h, color);
+}
+
+void canvas_init(GFX_t *gfx) {
+    memset(gfx, 0, sizeof(*gfx));
+    GFX_Init(gfx, CANVAS_W, CANVAS_H);
+    gfx->drawPixel = canvas_pixel;
+    gfx->drawFastHLine = canvas_hline;
+    gfx->drawFastVLine = canvas_vline;
+    gfx->fillRect = canvas_fill;
+}
+
+void canvas_clear(void) {
+    memset(canvas, 0, sizeof(canvas));
+    memset(canvas_hits, 0, sizeof(canvas_hits));
+    canvas_calls = 0;
+    canvas_outside = 0;
+}
+
+void canvas_pixels_only(GFX_t *gfx) {
+    gfx->drawFastHLine = NULL;
+    gfx->drawFastVLine = NULL;
+    gfx->fillRect = NULL;
+}
+
+bool canvas_compare(GFX_t *gfx, const char *name, canvas_draw_fn draw, const int16_t *args, int nargs,
+                    canvas_diff_t *diff) {
+    static uint16_t want[CANVAS_H][CANVAS_W];
+    bool same;
+    int i;
+
+    canvas_clear();
+    draw(gfx, true, args);
+    memcpy(want, canvas, sizeof(want));
+    diff->ref_calls += canvas_calls;
+
+    canvas_clear();
+    draw(gfx, false, args);
+    diff->calls += canvas_calls;
+    diff->cases++;
+    if (canvas_outside) {
+        diff->outside++;
+    }
+
+    same = (memcmp(want, canvas, sizeof(want)) == 0);
+    if (!same && diff->differ++ < CANVAS_SHOW_DIFFER) {
+        printf("%s(", name);
+        for (i = 0; i < nargs; i++) {
+            printf((i > 0) ? ", %d" : "%d", args[i]);
+        }
+        printf(") differs%s\n", gfx->drawFastHLine ? "" : " without span hooks");
+    }
+    return same;
+}
+
+void canvas_report(const char *what, const canvas_diff_t *diff) {
+    CHECK(diff->differ == 0, "%s: %lu of %lu cases differ from the reference", what, diff->differ, diff->cases);
+    CHECK(diff->outside == 0, "%s: %lu cases drawn off the canvas", what, diff->outside);
+    printf("%s: %lu hook calls, %lu with the reference\n", what, diff->calls, diff->ref_calls);
+}
@@ -0,0 +1,98 @@
+/**
+ * @file canvas.h
+ * @brief GFX_t whose hooks draw into memory, for checking rasterisers
+ *
+ * Registers drawPixel, drawFastHLine, drawFastVLine and fillRect hooks
+ * that record every pixel they are given, how often each pixel was
+ * written and how many hook calls it took. Writes outside the canvas are
+ * counted rather than stored. canvas_compare draws a case with a
+ * rasteriser's previous version and its current one and compares the
+ * pixels, which is how the GFX rewrites are checked.
+ *
+ * @author @btondin
+ * @date 2025
+ */
+
+#ifndef HOST_CANVAS_H
+#define HOST_CANVAS_H
+
+#include "gfx_pic.h"
+
+/** @brief Canvas width in pixels */
+#define CANVAS_W    96
+
+/** @brief Canvas height in pixels */
+#define CANVAS_H    64
+
+/** @brief Last colour written to each pixel */
+extern uint16_t canvas[CANVAS_H][CANVAS_W];
+
+/** @brief Number of writes to each pixel */
+extern uint8_t canvas_hits[CANVAS_H][CANVAS_W];
+
+/** @brief Hook calls since the last canvas_clear() */
+extern unsigned long canvas_calls;
+
+/** @brief Pixels written outside the canvas since the last canvas_clear() */
+extern unsigned long canvas_outside;
+
+/**
+ * @brief Initialise a graphics context that draws into the canvas
+ * @param gfx Graphics context
+ */
+void canvas_init(GFX_t *gfx);
+
+/**
+ * @brief Clear the canvas and its counters
+ */
+void canvas_clear(void);
+
+/**
+ * @brief Remove the span hooks, leaving the GFX fallbacks to draw pixel by pixel
+ * @param gfx Graphics context set up by canvas_init
+ */
+void canvas_pixels_only(GFX_t *gfx);
+
+/**
+ * @brief Draws one case into gfx
+ * @param gfx Graphics context set up by canvas_init
+ * @param ref true to draw with the reference, false with the code under test
+ * @param args Arguments of the case
+ */
+typedef void (*canvas_draw_fn)(GFX_t *gfx, bool ref, const int16_t *args);
+
+/** @brief Totals kept by canvas_compare */
+typedef struct {
+    unsigned long cases;        ///< Cases compared
+    unsigned long differ;       ///< Cases whose pixels differ
+    unsigned long ref_calls;    ///< Hook calls the reference took
+    unsigned long calls;        ///< Hook calls the code under test took
+    unsigned long outside;      ///< Cases the code under test drew off the canvas
+} canvas_diff_t;
+
+/**
+ * @brief Draw a case with the reference and the code under test and
+ *        compare the pixels
+ *
+ * The first few differing cases are printed with their arguments. The
+ * canvas is left as the code under test drew it.
+ *
+ * @param gfx Graphics context set up by canvas_init
+ * @param name Name printed with a differing case
+ * @param draw Draws the case
+ * @param args Arguments of the case
+ * @param nargs Number of arguments
+ * @param diff Totals to update
+ * @return true if both versions wrote the same pixels
+ */
+bool canvas_compare(GFX_t *gfx, const char *name, canvas_draw_fn draw, const int16_t *args, int nargs,
+                    canvas_diff_t *diff);
+
+/**
+ * @brief Fail the test on any differing or stray case and print the hook calls
+ * @param what Description of the comparison
+ * @param diff Totals kept by canvas_compare
+ */
+void canvas_report(const char *what, const canvas_diff_t *diff);
+
+#endif /* HOST_CANVAS_H */
@@ -0,0 +1,12 @@
+/**
+ * @file conio.h
+ * @brief Host stand-in for the XC8 console header included by mcc.h
+ *
+ * @author @btondin
+ * @date 2025
+ */
+
+#ifndef HOST_CONIO_H
+#define HOST_CONIO_H
+
+#endif /* HOST_CONIO_H */
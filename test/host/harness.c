@@ -0,0 +1,82 @@
+/**
+ * @file harness.c
+ * @brief Display setup and result checks shared by the host tests
+ *
+ * @author @btondin
+ * @date 2025
+ */
+
+#include "harness.h"
+#include <string.h>
+
+SSD1331_t oled;
+unsigned harness_failures;
+
+#if defined(SSD1331_USE_DMA)
+const char *const harness_mode = "dma";
+#elif defined(SSD1331_USE_QUEUE) && defined(SSD1331_QUEUE_DROP)
+const char *const harness_mode = "queue_drop";
+#elif defined(SSD1331_USE_QUEUE)
+const char *const harness_mode = "queue";
+#else
+const char *const harness_mode = "blocking";
+#endif
+
+void SYSTEM_Initialize(void) {
+}
+
+void harness_begin(uint8_t rotation) {
+#if defined(SSD1331_USE_DMA) || defined(SSD1331_USE_QUEUE)
+    host_init(SSD1331_InterruptHandler);
+    INTCON0bits.GIE = 1;
+#else
+    host_init(NULL);
+#endif
+    SPI1_Open(SPI1_DEFAULT);
+    SSD1331_Init(&oled);
+    SSD1331_Begin(&oled);
+    SSD1331_SetRotation(&oled, rotation);
+    SSD1331_FillScreen(&oled, 0);
+    panel_reset();
+    harness_settle();
+}
+
+panel_stats_t harness_settle(void) {
+#if defined(SSD1331_USE_DMA)
+    SSD1331_WaitDMA(&oled);
+#elif defined(SSD1331_USE_QUEUE)
+    SSD1331_Flush(&oled);
+#endif
+    CHECK(host_drain(), "SPI1 never went idle");
+    CHECK(host_check(harness_mode) == 0, "SPI1/DMA1 protocol violation");
+    return panel_decode();
+}
+
+/**
+ * @brief Clear the screen, then draw one version of a scene
+ */
+static panel_stats_t harness_draw_scene(harness_scene_fn scene, bool ref) {
+    SSD1331_FillScreen(&oled, 0);
+    harness_settle();
+    scene(ref);
+    return harness_settle();
+}
+
+panel_stats_t harness_compare_scene(const char *name, harness_scene_fn scene) {
+    static uint16_t frame[PANEL_ROWS][PANEL_COLS];
+    panel_stats_t old_st = harness_draw_scene(scene, true), new_st;
+    unsigned long before = old_st.cmd_bytes + old_st.data_bytes, after;
+
+    memcpy(frame, panel_ram, sizeof(frame));
+    new_st = harness_draw_scene(scene, false);
+    after = new_st.cmd_bytes + new_st.data_bytes;
+    CHECK(memcmp(frame, panel_ram, sizeof(frame)) == 0, "%s: different frame from the reference", name);
+    CHECK(after < before, "%s: %lu SPI bytes, %lu with the reference", name, after, before);
+    printf("%s: %lu SPI bytes, %lu with the reference\n", name, after, before);
+    return new_st;
+}
+
+int harness_end(const char *name) {
+    printf("%s (%s): %s\n", name, harness_mode, harness_failures ? "FAILED" : "passed");
+    return harness_failures ? 1 : 0;
+}
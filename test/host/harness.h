@@ -0,0 +1,84 @@
+/**
+ * @file harness.h
+ * @brief Display setup and result checks shared by the host tests
+ *
+ * Each test program is built once per driver mode (blocking,
+ * SSD1331_USE_DMA and SSD1331_USE_QUEUE). The harness brings the display
+ * up the way main.c does, with interrupts enabled first in the
+ * interrupt-driven modes, and waits for background transfers before the
+ * captured traffic is decoded.
+ *
+ * @author @btondin
+ * @date 2025
+ */
+
+#ifndef HARNESS_H
+#define HARNESS_H
+
+#include "ssd1331.h"
+#include "host.h"
+#include "panel.h"
+#include <stdio.h>
+
+/** @brief Display driven by the test */
+extern SSD1331_t oled;
+
+/** @brief Checks that failed so far */
+extern unsigned harness_failures;
+
+/** @brief Name of the driver mode the program was built for */
+extern const char *const harness_mode;
+
+/**
+ * @brief Record a failed check unless cond holds
+ */
+#define CHECK(cond, ...) do { \
+    if (!(cond)) { \
+        harness_failures++; \
+        printf("FAIL %s:%d: ", __FILE__, __LINE__); \
+        printf(__VA_ARGS__); \
+        printf("\n"); \
+    } \
+} while (0)
+
+/**
+ * @brief Reset the simulated hardware and bring the display up
+ * @param rotation Rotation to select after SSD1331_Begin
+ */
+void harness_begin(uint8_t rotation);
+
+/**
+ * @brief Wait for background transfers, then decode the captured traffic
+ *
+ * Also fails the test on any protocol violation the stand-in detected.
+ *
+ * @return Byte counts of the decoded traffic
+ */
+panel_stats_t harness_settle(void);
+
+/**
+ * @brief Draws a scene through the driver
+ * @param ref true to draw with the reference, false with the code under test
+ */
+typedef void (*harness_scene_fn)(bool ref);
+
+/**
+ * @brief Draw a scene with the reference and with the code under test
+ *
+ * Each version starts from a cleared screen. The code under test must
+ * give the same frame for fewer SPI bytes, and both byte counts are
+ * printed.
+ *
+ * @param name Scene name for messages
+ * @param scene Draws the scene
+ * @return Traffic of the code under test, whose frame is left in panel_ram
+ */
+panel_stats_t harness_compare_scene(const char *name, harness_scene_fn scene);
+
+/**
+ * @brief Print the result line and return the process exit code
+ * @param name Test name
+ */
+int harness_end(const char *name);
+
+#endif /* HARNESS_H */
@@ -0,0 +1,454 @@
+/**
+ * @file host.c
+ * @brief Simulated SPI1 and DMA1 behind the host register stand-in
+ *
+ * @author @btondin
+ * @date 2025
+ */
+
+#include <xc.h>
+#include "host.h"
+#include <signal.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/time.h>
+
+//==============================================================================
+// SIMULATION CONSTANTS
+//==============================================================================
+
+/** @brief Microseconds of real time between timer signals */
+#define HOST_SIGNAL_US      100
+
+/** @brief Ticks one timer signal lets pass */
+#define HOST_SIGNAL_TICKS   256
+
+/** @brief Ticks host_drain() waits before it calls the bus stalled */
+#define HOST_DRAIN_TICKS    (64ul * 1024 * 1024)
+
+/** @brief DMA1SIRQ value of the SPI1 transmit trigger */
+#define HOST_DMA_SPI1TX     0x15
+
+/** @brief DMA1CON1 DSTP: clear SIRQEN when the destination counter reloads */
+#define HOST_DMA_DSTP       0x20
+
+/** @brief DMA1CON1 SMODE field: 1 increments the source pointer */
+#define HOST_DMA_SMODE(con1) (((con1) >> 1) & 3)
+
+//==============================================================================
+// STATE
+//==============================================================================
+
+volatile host_regs_t host_regs;
+volatile uint8_t host_sink;
+
+host_byte_t host_capture[HOST_CAPTURE_MAX];
+size_t host_captured;
+host_faults_t host_faults;
+host_dma_burst_t host_dma_log[HOST_LOG_MAX];
+size_t host_dma_bursts;
+unsigned long host_interrupts;
+uint64_t host_ticks;
+
+/**
+ * @brief SPI1 transmit path
+ */
+static struct {
+    uint8_t fifo[2];        ///< Transmit FIFO
+    uint8_t count;          ///< Bytes in the transmit FIFO
+    uint8_t rx_count;       ///< Bytes in the receive FIFO
+    uint8_t rx[2];          ///< Receive FIFO
+    uint8_t shift;          ///< Byte on the wire
+    uint8_t shift_ticks;    ///< Ticks until it has been sent, 0 when idle
+    uint8_t dc;             ///< D/C level when the byte started
+    uint8_t cs;             ///< CS level when the byte started
+    bool glitched;          ///< D/C or CS moved during the byte
+    bool stalled;           ///< FIFO holds bytes but SPI1TCNT is zero
+} spi;
+
+/**
+ * @brief DMA1 channel
+ */
+static struct {
+    bool running;           ///< EN and SIRQEN were set at the last tick
+    uint16_t scount;        ///< Source bytes read since the last reload
+    uint16_t dcount;        ///< Destination bytes written since the last reload
+} dma;
+
+static void (*host_isr)(void);
+static volatile int host_depth;         ///< Nesting of register accesses in progress
+static volatile bool host_in_isr;       ///< The interrupt routine is running
+static volatile bool host_pending;      ///< A timer signal arrived during an access
+static unsigned host_busy_reads;        ///< BUSY reads in this interrupt
+
+//==============================================================================
+// SPI1 AND DMA1 MODEL
+//==============================================================================
+
+/**
+ * @brief Put a byte into the transmit FIFO
+ * 
+ * A byte written while the FIFO is full is lost, as on the device;
+ * host_write_txb() has counted the fault already.
+ * 
+ * @param b Byte written to SPI1TXB
+ */
+static void host_push(uint8_t b) {
+    if (spi.count < 2) {
+        spi.fifo[spi.count++] = b;
+    }
+}
+
+/**
+ * @brief Whether a byte is still anywhere between SPI1TXB and the wire
+ */
+static bool host_tx_pending(void) {
+    return spi.shift_ticks || spi.count || host_regs.spi1txb != HOST_TXB_EMPTY;
+}
+
+/**
+ * @brief Recompute the flags that follow the state of SPI1
+ */
+static void host_update_flags(void) {
+    volatile host_regs_t *r = &host_regs;
+    uint8_t intf, inte;
+
+    r->pir2.SPI1TXIF = (spi.count < 2) && (r->spi1txb == HOST_TXB_EMPTY);
+    r->pir2.SPI1RXIF = spi.rx_count > 0;
+    r->spi1con2.BUSY = host_tx_pending();
+
+    memcpy(&intf, (const void *)&r->spi1intf, 1);
+    memcpy(&inte, (const void *)&r->spi1inte, 1);
+    r->pir2.SPI1IF = (intf & inte) != 0;
+}
+
+/**
+ * @brief Move one byte from the DMA source into the transmit FIFO
+ */
+static void host_dma_tick(void) {
+    volatile host_regs_t *r = &host_regs;
+    bool on = r->dma1con0.EN && r->dma1con0.SIRQEN;
+    uintptr_t src;
+
+    if (on && !dma.running) {
+        dma.scount = 0;
+        dma.dcount = 0;
+        if (host_dma_bursts < HOST_LOG_MAX) {
+            host_dma_log[host_dma_bursts].size = r->dma1dsz;
+            host_dma_log[host_dma_bursts].tcnt = r->spi1tcnt;
+            host_dma_log[host_dma_bursts].ssz = r->dma1ssz;
+        }
+        host_dma_bursts++;
+    }
+    dma.running = on;
+
+    if (!on || r->dma1sirq != HOST_DMA_SPI1TX || spi.count == 2 || r->spi1txb != HOST_TXB_EMPTY) {
+        return;
+    }
+
+    src = r->dma1ssa;
+    if (HOST_DMA_SMODE(r->dma1con1) == 1) {
+        src += dma.scount;
+    }
+    host_push(*(const uint8_t *)src);
+
+    if (++dma.scount == r->dma1ssz) {
+        dma.scount = 0;
+    }
+    if (++dma.dcount == r->dma1dsz) {
+        dma.dcount = 0;
+        r->pir2.DMA1DCNTIF = 1;
+        if (r->dma1con1 & HOST_DMA_DSTP) {
+            r->dma1con0.SIRQEN = 0;
+            dma.running = false;
+        }
+    }
+}
+
+/**
+ * @brief Advance SPI1 and DMA1 by one tick
+ */
+static void host_tick(void) {
+    volatile host_regs_t *r = &host_regs;
+    uint8_t dc = r->latc.LATC0, cs = r->latc.LATC1;
+    bool finished = false;
+
+    host_ticks++;
+
+    if (r->spi1txb != HOST_TXB_EMPTY) {
+        host_push((uint8_t)r->spi1txb);
+        r->spi1txb = HOST_TXB_EMPTY;
+    }
+    if (r->spi1tcnt > 0x7FF) {
+        host_faults.tcnt_range++;
+        r->spi1tcnt &= 0x7FF;
+    }
+
+    host_dma_tick();
+
+    if (spi.shift_ticks) {
+        if (dc != spi.dc || cs != spi.cs) {
+            spi.glitched = true;
+        }
+        if (--spi.shift_ticks == 0) {
+            if (host_captured < HOST_CAPTURE_MAX) {
+                host_capture[host_captured].data = spi.shift;
+                host_capture[host_captured].dc = dc;
+                host_capture[host_captured].cs = cs;
+                host_captured++;
+            }
+            if (spi.glitched) {
+                host_faults.pin_glitch++;
+            }
+            if (r->spi1con2.RXR && spi.rx_count < 2) {
+                spi.rx[spi.rx_count++] = spi.shift;
+            }
+            if (r->spi1tcnt) {
+                r->spi1tcnt--;
+            }
+            finished = true;
+        }
+    }
+
+    if (!spi.shift_ticks && spi.count && r->spi1con0.EN) {
+        if (r->spi1tcnt == 0) {
+            if (!spi.stalled) {
+                host_faults.tx_stall++;
+                spi.stalled = true;
+            }
+        } else if (!(r->spi1con2.RXR && spi.rx_count == 2)) {
+            spi.shift = spi.fifo[0];
+            spi.fifo[0] = spi.fifo[1];
+            spi.count--;
+            spi.shift_ticks = HOST_BYTE_TICKS;
+            spi.dc = dc;
+            spi.cs = cs;
+            spi.glitched = false;
+            spi.stalled = false;
+        }
+    }
+
+    // Shift register empty: the last byte is out and no other follows
+    if (finished && !spi.shift_ticks) {
+        r->spi1intf.SRMTIF = 1;
+    }
+
+    host_update_flags();
+}
+
+//==============================================================================
+// INTERRUPTS AND TIME
+//==============================================================================
+
+/**
+ * @brief Run the interrupt routine if an enabled interrupt is pending
+ */
+static void host_dispatch(void) {
+    volatile host_regs_t *r = &host_regs;
+
+    if (host_in_isr || host_isr == NULL || !r->intcon0.GIE) {
+        return;
+    }
+    host_update_flags();
+    if ((r->pie2.DMA1DCNTIE && r->pir2.DMA1DCNTIF) ||
+        (r->pie2.SPI1TXIE && r->pir2.SPI1TXIF) ||
+        (r->pie2.SPI1RXIE && r->pir2.SPI1RXIF) ||
+        (r->pie2.SPI1IE && r->pir2.SPI1IF)) {
+        host_in_isr = true;
+        host_busy_reads = 0;
+        host_interrupts++;
+        host_isr();
+        host_in_isr = false;
+    }
+}
+
+/**
+ * @brief Let ticks pass, taking interrupts between them
+ * @param ticks Number of ticks
+ */
+static void host_advance(uint32_t ticks) {
+    while (ticks--) {
+        host_tick();
+        host_dispatch();
+    }
+}
+
+/**
+ * @brief Enter a register access; timer signals are held off until it ends
+ */
+static void host_enter(void) {
+    host_depth++;
+}
+
+/**
+ * @brief Leave a register access, catching up on held-off timer signals
+ */
+static void host_leave(void) {
+    if (host_depth == 1) {
+        while (host_pending) {
+            host_pending = false;
+            host_advance(HOST_SIGNAL_TICKS);
+        }
+    }
+    host_depth--;
+}
+
+/**
+ * @brief Timer signal: time passes while the CPU spins on plain memory
+ * @param sig Signal number (unused)
+ */
+static void host_signal(int sig) {
+    (void)sig;
+    if (host_depth) {
+        host_pending = true;
+        return;
+    }
+    host_depth = 1;
+    host_advance(HOST_SIGNAL_TICKS);
+    host_depth = 0;
+}
+
+//==============================================================================
+// REGISTER ACCESS HOOKS
+//==============================================================================
+
+volatile host_regs_t *host_step(void) {
+    host_enter();
+    host_advance(1);
+    host_leave();
+    return &host_regs;
+}
+
+volatile host_regs_t *host_read_con2(void) {
+    host_enter();
+    host_advance(1);
+
+    // Reading BUSY twice in one interrupt means the interrupt waits for SPI1
+    if (host_in_isr && host_regs.spi1con2.BUSY && host_busy_reads++) {
+        host_faults.isr_busy_wait++;
+    }
+    host_leave();
+    return &host_regs;
+}
+
+volatile host_regs_t *host_write_txb(void) {
+    host_enter();
+    host_advance(1);
+    if (host_regs.spi1txb != HOST_TXB_EMPTY) {
+        host_push((uint8_t)host_regs.spi1txb);
+        host_regs.spi1txb = HOST_TXB_EMPTY;
+    }
+    if (spi.count == 2) {
+        host_faults.tx_overflow++;
+    }
+    host_leave();
+    return &host_regs;
+}
+
+volatile host_regs_t *host_write_tcnt(void) {
+    host_enter();
+    host_advance(1);
+
+    // A new count replaces the one the pending bytes were sent under
+    if (host_tx_pending()) {
+        host_faults.tcnt_busy++;
+    }
+    host_leave();
+    return &host_regs;
+}
+
+uint8_t host_read_rxb(void) {
+    uint8_t b = 0;
+
+    host_enter();
+    host_advance(1);
+    if (spi.rx_count) {
+        b = spi.rx[0];
+        spi.rx[0] = spi.rx[1];
+        spi.rx_count--;
+    }
+    host_update_flags();
+    host_leave();
+    return b;
+}
+
+void host_delay_us(uint32_t us) {
+    host_enter();
+    host_advance(us * HOST_US_TICKS);
+    host_leave();
+}
+
+//==============================================================================
+// TEST INTERFACE
+//==============================================================================
+
+void host_init(void (*isr)(void)) {
+    static bool timer_started;
+
+    if (!timer_started) {
+        struct sigaction sa;
+        struct itimerval it;
+
+        memset(&sa, 0, sizeof(sa));
+        sa.sa_handler = host_signal;
+        sa.sa_flags = SA_RESTART;
+        sigaction(SIGALRM, &sa, NULL);
+
+        it.it_interval.tv_sec = 0;
+        it.it_interval.tv_usec = HOST_SIGNAL_US;
+        it.it_value = it.it_interval;
+        setitimer(ITIMER_REAL, &it, NULL);
+        timer_started = true;
+    }
+
+    host_enter();
+    memset((void *)&host_regs, 0, sizeof(host_regs));
+    memset(&spi, 0, sizeof(spi));
+    memset(&dma, 0, sizeof(dma));
+    memset(&host_faults, 0, sizeof(host_faults));
+    host_regs.spi1txb = HOST_TXB_EMPTY;
+    host_regs.latc.LATC1 = 1;
+    host_captured = 0;
+    host_dma_bursts = 0;
+    host_interrupts = 0;
+    host_ticks = 0;
+    host_isr = isr;
+    host_update_flags();
+    host_leave();
+}
+
+void host_clear_capture(void) {
+    host_captured = 0;
+}
+
+bool host_drain(void) {
+    uint64_t start = host_ticks;
+    bool idle;
+
+    host_enter();
+    for (;;) {
+        idle = !host_tx_pending() && !dma.running;
+        if (idle || host_ticks - start > HOST_DRAIN_TICKS) {
+            break;
+        }
+        host_advance(1);
+    }
+    host_leave();
+    return idle;
+}
+
+bool host_in_interrupt(void) {
+    return host_in_isr;
+}
+
+unsigned long host_check(const char *what) {
+    host_faults_t f = host_faults;
+    unsigned long n = f.tcnt_busy + f.tcnt_range + f.tx_overflow + f.tx_stall + f.pin_glitch + f.isr_busy_wait;
+
+    if (n) {
+        printf("%s: tcnt_busy=%lu tcnt_range=%lu tx_overflow=%lu tx_stall=%lu pin_glitch=%lu isr_busy_wait=%lu\n",
+               what, f.tcnt_busy, f.tcnt_range, f.tx_overflow, f.tx_stall, f.pin_glitch, f.isr_busy_wait);
+    }
+    memset(&host_faults, 0, sizeof(host_faults));
+    return n;
+}
@@ -0,0 +1,107 @@
+/**
+ * @file host.h
+ * @brief Simulated SPI1 and DMA1 behind the host register stand-in
+ *
+ * SPI1 shifts one byte every HOST_BYTE_TICKS ticks out of a two-byte
+ * transmit FIFO, gated by SPI1TCNT, and records each byte with the D/C
+ * and CS levels the panel samples at its last clock. DMA1 moves one byte
+ * per tick from its source into SPI1TXB while the FIFO has room. Time
+ * advances on every register access and, through a periodic timer
+ * signal, while the CPU spins on plain variables, so interrupt-driven
+ * code runs the way it does on the device: the interrupt routine
+ * preempts the main program between any two of its instructions.
+ *
+ * @author @btondin
+ * @date 2025
+ */
+
+#ifndef HOST_H
+#define HOST_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+/** @brief Ticks SPI1 needs per byte */
+#define HOST_BYTE_TICKS     8
+
+/** @brief Ticks per microsecond of __delay_us() */
+#define HOST_US_TICKS       8
+
+/** @brief Bytes the capture buffer holds */
+#define HOST_CAPTURE_MAX    (1ul << 20)
+
+/** @brief DMA1 bursts the burst log holds */
+#define HOST_LOG_MAX        4096
+
+/**
+ * @brief One byte as the panel received it
+ */
+typedef struct {
+    uint8_t data;   ///< Byte value
+    uint8_t dc;     ///< D/C level at the last clock (1 = data)
+    uint8_t cs;     ///< CS level at the last clock (1 = not selected)
+} host_byte_t;
+
+/**
+ * @brief One DMA1 burst, recorded when the DMA starts moving it
+ */
+typedef struct {
+    uint16_t size;  ///< DMA1DSZ: bytes the burst writes to SPI1TXB
+    uint16_t tcnt;  ///< SPI1TCNT when the burst started
+    uint16_t ssz;   ///< DMA1SSZ: source bytes before the source reloads
+} host_dma_burst_t;
+
+/**
+ * @brief Protocol violations the stand-in detected
+ */
+typedef struct {
+    unsigned long tcnt_busy;      ///< SPI1TCNT written while bytes were still pending
+    unsigned long tcnt_range;     ///< SPI1TCNT written with more than 11 bits
+    unsigned long tx_overflow;    ///< SPI1TXB written while the FIFO was full
+    unsigned long tx_stall;       ///< Bytes left in the FIFO with SPI1TCNT at zero
+    unsigned long pin_glitch;     ///< D/C or CS changed while a byte was on the wire
+    unsigned long isr_busy_wait;  ///< BUSY polled again inside one interrupt
+} host_faults_t;
+
+extern host_byte_t host_capture[];
+extern size_t host_captured;
+extern host_faults_t host_faults;
+extern host_dma_burst_t host_dma_log[];
+extern size_t host_dma_bursts;
+extern unsigned long host_interrupts;
+extern uint64_t host_ticks;
+
+/**
+ * @brief Reset every register and log, and start simulated time
+ * @param isr Interrupt routine to run when an enabled flag is set (may be NULL)
+ */
+void host_init(void (*isr)(void));
+
+/**
+ * @brief Forget the captured bytes, keeping the register state
+ */
+void host_clear_capture(void);
+
+/**
+ * @brief Let simulated time pass until SPI1 and DMA1 are idle
+ *
+ * Returns at once when nothing is pending. Interrupts keep running.
+ *
+ * @return false when the bus did not go idle (a stalled transfer)
+ */
+bool host_drain(void);
+
+/**
+ * @brief Whether the interrupt routine is running
+ */
+bool host_in_interrupt(void);
+
+/**
+ * @brief Report protocol violations and reset their counters
+ * @param what Name printed with any violation
+ * @return Number of violations found
+ */
+unsigned long host_check(const char *what);
+
+#endif /* HOST_H */
@@ -0,0 +1,243 @@
+/**
+ * @file panel.c
+ * @brief Model of the SSD1331 display RAM fed from the captured SPI bytes
+ *
+ * @author @btondin
+ * @date 2025
+ */
+
+#include "panel.h"
+#include "host.h"
+#include <stdbool.h>
+#include <string.h>
+
+uint16_t panel_ram[PANEL_ROWS][PANEL_COLS];
+
+/**
+ * @brief Controller registers and the command being received
+ */
+static struct {
+    int c0, c1, r0, r1;     ///< Column and row window
+    int col, row;           ///< Write pointer
+    bool vertical;          ///< Address increment runs down the columns
+    bool fill;              ///< DRAWRECT fills the inside
+    uint8_t cmd;            ///< Command being received
+    uint8_t args[16];       ///< Its argument bytes
+    int need;               ///< Argument bytes it takes, -1 between commands
+    int got;                ///< Argument bytes received
+    uint8_t high;           ///< First byte of a pixel
+    bool half;              ///< The first byte of a pixel has arrived
+} panel;
+
+/**
+ * @brief Number of argument bytes that follow a command byte
+ */
+static int panel_args(uint8_t cmd) {
+    switch (cmd) {
+        case 0x15: case 0x75:                   // SETCOLUMN, SETROW
+            return 2;
+        case 0x21:                              // DRAWLINE
+            return 7;
+        case 0x22:                              // DRAWRECT
+            return 10;
+        case 0x23:                              // COPY
+            return 6;
+        case 0x24: case 0x25:                   // DIM, CLEAR
+            return 4;
+        case 0x27:                              // SCROLLSETUP
+            return 5;
+        case 0x26: case 0x81: case 0x82: case 0x83: case 0x87:
+        case 0x8A: case 0x8B: case 0x8C: case 0xA0: case 0xA1:
+        case 0xA2: case 0xA8: case 0xAD: case 0xB0: case 0xB1:
+        case 0xB3: case 0xBB: case 0xBE:
+            return 1;
+        default:
+            return 0;
+    }
+}
+
+/**
+ * @brief RGB565 from the 6-bit colour components of a drawing command
+ */
+static uint16_t panel_color(uint8_t r, uint8_t g, uint8_t b) {
+    return (uint16_t)(((r >> 1) << 11) | ((g & 0x3F) << 5) | (b >> 1));
+}
+
+static void panel_put(int col, int row, uint16_t color) {
+    if (col >= 0 && col < PANEL_COLS && row >= 0 && row < PANEL_ROWS) {
+        panel_ram[row][col] = color;
+    }
+}
+
+static void panel_line(int x0, int y0, int x1, int y1, uint16_t color) {
+    int dx = (x1 > x0) ? x1 - x0 : x0 - x1, sx = (x0 < x1) ? 1 : -1;
+    int dy = -((y1 > y0) ? y1 - y0 : y0 - y1), sy = (y0 < y1) ? 1 : -1;
+    int err = dx + dy, e2;
+
+    for (;;) {
+        panel_put(x0, y0, color);
+        if (x0 == x1 && y0 == y1) {
+            break;
+        }
+        e2 = 2 * err;
+        if (e2 >= dy) {
+            err += dy;
+            x0 += sx;
+        }
+        if (e2 <= dx) {
+            err += dx;
+            y0 += sy;
+        }
+    }
+}
+
+/**
+ * @brief Carry out a command once all its arguments have arrived
+ */
+static void panel_execute(void) {
+    static uint16_t copy[PANEL_ROWS][PANEL_COLS];
+    const uint8_t *a = panel.args;
+    int r, c;
+
+    switch (panel.cmd) {
+        case 0x15:
+            panel.c0 = a[0];
+            panel.c1 = a[1];
+            panel.col = panel.c0;
+            panel.row = panel.r0;
+            break;
+
+        case 0x75:
+            panel.r0 = a[0];
+            panel.r1 = a[1];
+            panel.col = panel.c0;
+            panel.row = panel.r0;
+            break;
+
+        case 0xA0:
+            panel.vertical = a[0] & 0x01;
+            break;
+
+        case 0x26:
+            panel.fill = a[0] & 0x01;
+            break;
+
+        case 0x21:
+            panel_line(a[0], a[1], a[2], a[3], panel_color(a[4], a[5], a[6]));
+            break;
+
+        case 0x22:
+            for (r = a[1]; r <= a[3]; r++) {
+                for (c = a[0]; c <= a[2]; c++) {
+                    if (r == a[1] || r == a[3] || c == a[0] || c == a[2]) {
+                        panel_put(c, r, panel_color(a[4], a[5], a[6]));
+                    } else if (panel.fill) {
+                        panel_put(c, r, panel_color(a[7], a[8], a[9]));
+                    }
+                }
+            }
+            break;
+
+        case 0x23:
+            memcpy(copy, panel_ram, sizeof(copy));
+            for (r = a[1]; r <= a[3]; r++) {
+                for (c = a[0]; c <= a[2]; c++) {
+                    if (r < PANEL_ROWS && c < PANEL_COLS) {
+                        panel_put(a[4] + c - a[0], a[5] + r - a[1], copy[r][c]);
+                    }
+                }
+            }
+            break;
+
+        case 0x25:
+            for (r = a[1]; r <= a[3]; r++) {
+                for (c = a[0]; c <= a[2]; c++) {
+                    panel_put(c, r, 0);
+                }
+            }
+            break;
+    }
+}
+
+/**
+ * @brief Store a pixel at the write pointer and advance it
+ */
+static void panel_pixel(uint16_t color) {
+    panel_put(panel.col, panel.row, color);
+    if (!panel.vertical) {
+        if (++panel.col > panel.c1) {
+            panel.col = panel.c0;
+            if (++panel.row > panel.r1) {
+                panel.row = panel.r0;
+            }
+        }
+    } else {
+        if (++panel.row > panel.r1) {
+            panel.row = panel.r0;
+            if (++panel.col > panel.c1) {
+                panel.col = panel.c0;
+            }
+        }
+    }
+}
+
+void panel_reset(void) {
+    memset(panel_ram, 0, sizeof(panel_ram));
+    memset(&panel, 0, sizeof(panel));
+    panel.c1 = PANEL_COLS - 1;
+    panel.r1 = PANEL_ROWS - 1;
+    panel.need = -1;
+}
+
+panel_stats_t panel_decode(void) {
+    panel_stats_t st = {0, 0, 0};
+    size_t i;
+
+    for (i = 0; i < host_captured; i++) {
+        const host_byte_t *b = &host_capture[i];
+
+        if (b->cs) {
+            st.unselected++;
+            continue;
+        }
+        if (!b->dc) {
+            st.cmd_bytes++;
+            panel.half = false;
+            if (panel.need < 0) {
+                panel.cmd = b->data;
+                panel.need = panel_args(b->data);
+                panel.got = 0;
+            } else {
+                panel.args[panel.got++] = b->data;
+            }
+            if (panel.got == panel.need) {
+                panel_execute();
+                panel.need = -1;
+            }
+            continue;
+        }
+
+        st.data_bytes++;
+        if (!panel.half) {
+            panel.high = b->data;
+            panel.half = true;
+        } else {
+            panel.half = false;
+            panel_pixel((uint16_t)((panel.high << 8) | b->data));
+        }
+    }
+    host_clear_capture();
+    return st;
+}
+
+uint32_t panel_hash(void) {
+    const uint8_t *p = (const uint8_t *)panel_ram;
+    uint32_t h = 2166136261u;
+    size_t i;
+
+    for (i = 0; i < sizeof(panel_ram); i++) {
+        h ^= p[i];
+        h *= 16777619u;
+    }
+    return h;
+}
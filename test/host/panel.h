@@ -0,0 +1,53 @@
+/**
+ * @file panel.h
+ * @brief Model of the SSD1331 display RAM fed from the captured SPI bytes
+ *
+ * Decodes the command and data stream the way the controller does:
+ * column and row windows, the address increment direction, the drawing
+ * engine commands and the write pointer. Pixels are kept in GDDRAM
+ * order, so two runs can be compared without undoing the rotation.
+ *
+ * @author @btondin
+ * @date 2025
+ */
+
+#ifndef PANEL_H
+#define PANEL_H
+
+#include <stdint.h>
+
+/** @brief GDDRAM columns */
+#define PANEL_COLS  96
+
+/** @brief GDDRAM rows */
+#define PANEL_ROWS  64
+
+/**
+ * @brief Byte counts of one decoded stretch of traffic
+ */
+typedef struct {
+    unsigned long cmd_bytes;    ///< Bytes sent with D/C low
+    unsigned long data_bytes;   ///< Bytes sent with D/C high
+    unsigned long unselected;   ///< Bytes sent while CS was high (ignored by the panel)
+} panel_stats_t;
+
+/** @brief Display RAM as the controller holds it, RGB565 */
+extern uint16_t panel_ram[PANEL_ROWS][PANEL_COLS];
+
+/**
+ * @brief Clear the display RAM and the decoder state
+ */
+void panel_reset(void);
+
+/**
+ * @brief Apply every captured byte to the display RAM and empty the capture
+ * @return Byte counts of the decoded traffic
+ */
+panel_stats_t panel_decode(void);
+
+/**
+ * @brief FNV-1a hash of the display RAM
+ */
+uint32_t panel_hash(void);
+
+#endif /* PANEL_H */
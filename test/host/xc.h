@@ -0,0 +1,178 @@
+/**
+ * @file xc.h
+ * @brief Host stand-in for the XC8 device header of the PIC18F26K42
+ *
+ * Declares only the registers the SSD1331 driver and the MCC SPI1 driver
+ * touch. Every register the hardware changes on its own (flags, BUSY,
+ * receive buffer, DMA control) is reached through host_step() or one of
+ * its variants, which let the simulated SPI1 and DMA1 advance between
+ * accesses and check when SPI1TXB, SPI1TCNT and BUSY are used.
+ *
+ * @author @btondin
+ * @date 2025
+ */
+
+#ifndef HOST_XC_H
+#define HOST_XC_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+//==============================================================================
+// COMPILER SUPPORT
+//==============================================================================
+
+typedef uintptr_t uint24_t;
+typedef uintptr_t __uint24;
+
+#define __interrupt(...)
+#define NOP()
+#define __delay_ms(x)   host_delay_us((uint32_t)(x) * 1000u)
+#define __delay_us(x)   host_delay_us((uint32_t)(x))
+
+//==============================================================================
+// REGISTER LAYOUT
+//==============================================================================
+
+typedef struct { unsigned LATA0:1, LATA1:1, LATA2:1, LATA3:1, LATA4:1, LATA5:1, LATA6:1, LATA7:1; } LATAbits_t;
+typedef struct { unsigned LATB0:1, LATB1:1, LATB2:1, LATB3:1, LATB4:1, LATB5:1, LATB6:1, LATB7:1; } LATBbits_t;
+typedef struct { unsigned LATC0:1, LATC1:1, LATC2:1, LATC3:1, LATC4:1, LATC5:1, LATC6:1, LATC7:1; } LATCbits_t;
+typedef struct { unsigned RA0:1, RA1:1, RA2:1, RA3:1, RA4:1, RA5:1, RA6:1, RA7:1; } PORTAbits_t;
+typedef struct { unsigned RB0:1, RB1:1, RB2:1, RB3:1, RB4:1, RB5:1, RB6:1, RB7:1; } PORTBbits_t;
+typedef struct { unsigned RC0:1, RC1:1, RC2:1, RC3:1, RC4:1, RC5:1, RC6:1, RC7:1; } PORTCbits_t;
+typedef struct { unsigned TRISA0:1, TRISA1:1, TRISA2:1, TRISA3:1, TRISA4:1, TRISA5:1, TRISA6:1, TRISA7:1; } TRISAbits_t;
+typedef struct { unsigned TRISB0:1, TRISB1:1, TRISB2:1, TRISB3:1, TRISB4:1, TRISB5:1, TRISB6:1, TRISB7:1; } TRISBbits_t;
+typedef struct { unsigned TRISC0:1, TRISC1:1, TRISC2:1, TRISC3:1, TRISC4:1, TRISC5:1, TRISC6:1, TRISC7:1; } TRISCbits_t;
+typedef struct { unsigned I2C1RXIF:1, SPI1IF:1, SPI1TXIF:1, SPI1RXIF:1, DMA1DCNTIF:1, DMA1SCNTIF:1, DMA1ORIF:1, DMA1AIF:1; } PIR2bits_t;
+typedef struct { unsigned I2C1RXIE:1, SPI1IE:1, SPI1TXIE:1, SPI1RXIE:1, DMA1DCNTIE:1, DMA1SCNTIE:1, DMA1ORIE:1, DMA1AIE:1; } PIE2bits_t;
+typedef struct { unsigned BMODE:1, MST:1, LSBF:1, _r:4, EN:1; } SPI1CON0bits_t;
+typedef struct { unsigned RXR:1, TXR:1, SSET:1, _r:3, SSFLT:1, BUSY:1; } SPI1CON2bits_t;
+typedef struct { unsigned _r:1, TXUIF:1, RXOIF:1, _r2:1, EOSIF:1, SOSIF:1, TCZIF:1, SRMTIF:1; } SPI1INTFbits_t;
+typedef struct { unsigned _r:1, TXUIE:1, RXOIE:1, _r2:1, EOSIE:1, SOSIE:1, TCZIE:1, SRMTIE:1; } SPI1INTEbits_t;
+typedef struct { unsigned XIP:1, _r:1, AIRQEN:1, _r2:2, DGO:1, SIRQEN:1, EN:1; } DMA1CON0bits_t;
+typedef struct { unsigned INT0EDG:1, INT1EDG:1, INT2EDG:1, _r:2, IPEN:1, GIEL:1, GIE:1; } INTCON0bits_t;
+typedef struct { unsigned PRLOCKED:1, _r:7; } PRLOCKbits_t;
+
+/**
+ * @brief Every register the stand-in models
+ */
+typedef struct {
+    LATAbits_t lata;
+    LATBbits_t latb;
+    LATCbits_t latc;
+    PORTAbits_t porta;
+    PORTBbits_t portb;
+    PORTCbits_t portc;
+    TRISAbits_t trisa;
+    TRISBbits_t trisb;
+    TRISCbits_t trisc;
+    PIR2bits_t pir2;
+    PIE2bits_t pie2;
+    SPI1CON0bits_t spi1con0;
+    SPI1CON2bits_t spi1con2;
+    SPI1INTFbits_t spi1intf;
+    SPI1INTEbits_t spi1inte;
+    DMA1CON0bits_t dma1con0;
+    INTCON0bits_t intcon0;
+    PRLOCKbits_t prlock;
+    uint16_t spi1txb;           ///< Byte written by the CPU, HOST_TXB_EMPTY once taken
+    uint16_t spi1tcnt;
+    uint8_t spi1con1, spi1baud, spi1clk;
+    uint8_t dma1con1, dma1sirq, dma1airq, dma1pr, mainpr, prlockreg;
+    uintptr_t dma1ssa;
+    uint16_t dma1ssz;
+    uint16_t dma1dsa;
+    uint16_t dma1dsz;
+} host_regs_t;
+
+/** @brief SPI1TXB value meaning no byte is waiting to enter the FIFO */
+#define HOST_TXB_EMPTY  0xFFFFu
+
+extern volatile host_regs_t host_regs;
+extern volatile uint8_t host_sink;
+
+volatile host_regs_t *host_step(void);
+volatile host_regs_t *host_read_con2(void);
+volatile host_regs_t *host_write_txb(void);
+volatile host_regs_t *host_write_tcnt(void);
+uint8_t host_read_rxb(void);
+void host_delay_us(uint32_t us);
+
+//==============================================================================
+// REGISTER NAMES
+//==============================================================================
+
+#define LATAbits        (host_regs.lata)
+#define LATBbits        (host_regs.latb)
+#define LATCbits        (host_regs.latc)
+#define PORTAbits       (host_regs.porta)
+#define PORTBbits       (host_regs.portb)
+#define PORTCbits       (host_regs.portc)
+#define TRISAbits       (host_regs.trisa)
+#define TRISBbits       (host_regs.trisb)
+#define TRISCbits       (host_regs.trisc)
+
+#define PIR2bits        (host_step()->pir2)
+#define PIE2bits        (host_step()->pie2)
+#define INTCON0bits     (host_step()->intcon0)
+
+#define SPI1CON0bits    (host_regs.spi1con0)
+#define SPI1CON0        (*(volatile uint8_t *)&host_regs.spi1con0)
+#define SPI1CON1        (host_regs.spi1con1)
+#define SPI1CON2bits    (host_read_con2()->spi1con2)
+#define SPI1CON2        (*(volatile uint8_t *)&host_step()->spi1con2)
+#define SPI1INTFbits    (host_step()->spi1intf)
+#define SPI1INTEbits    (host_step()->spi1inte)
+#define SPI1BAUD        (host_regs.spi1baud)
+#define SPI1CLK         (host_regs.spi1clk)
+#define SPI1TXB         (host_write_txb()->spi1txb)
+#define SPI1RXB         host_read_rxb()
+#define SPI1TCNT        (host_write_tcnt()->spi1tcnt)
+#define SPI1TCNTL       (*(volatile uint8_t *)&host_write_tcnt()->spi1tcnt)
+
+#define _SPI1CON2_SPI1RXR_MASK  0x01
+#define _SPI1CON2_SPI1TXR_MASK  0x02
+#define _SPI1CON2_RXR_MASK      0x01
+#define _SPI1CON2_TXR_MASK      0x02
+
+#define DMA1CON0bits    (host_step()->dma1con0)
+#define DMA1CON0        (*(volatile uint8_t *)&host_step()->dma1con0)
+#define DMA1CON1        (host_regs.dma1con1)
+#define DMA1SIRQ        (host_regs.dma1sirq)
+#define DMA1AIRQ        (host_regs.dma1airq)
+#define DMA1SSA         (host_regs.dma1ssa)
+#define DMA1SSZ         (host_regs.dma1ssz)
+#define DMA1DSA         (host_regs.dma1dsa)
+#define DMA1DSZ         (host_regs.dma1dsz)
+#define DMA1PR          (host_regs.dma1pr)
+#define MAINPR          (host_regs.mainpr)
+#define PRLOCK          (host_regs.prlockreg)
+#define PRLOCKbits      (host_regs.prlock)
+
+// Registers the MCC drivers configure but nothing here depends on
+#define LATA            host_sink
+#define LATB            host_sink
+#define LATC            host_sink
+#define TRISA           host_sink
+#define TRISB           host_sink
+#define TRISC           host_sink
+#define ANSELA          host_sink
+#define ANSELB          host_sink
+#define ANSELC          host_sink
+#define WPUA            host_sink
+#define WPUB            host_sink
+#define WPUC            host_sink
+#define WPUE            host_sink
+#define ODCONA          host_sink
+#define ODCONB          host_sink
+#define ODCONC          host_sink
+#define PMD0            host_sink
+#define PMD1            host_sink
+#define PMD2            host_sink
+#define PMD3            host_sink
+#define PMD4            host_sink
+#define PMD5            host_sink
+#define PMD6            host_sink
+#define PMD7            host_sink
+
+#endif /* HOST_XC_H */
@@ -0,0 +1,199 @@
+/**
+ * @file test_circle.c
+ * @brief Outline circles and round rects: spans draw the pixels of the
+ *        old eight-points-per-step loops, with fewer driver calls
+ *
+ * GFX_DrawCircle, GFX_DrawCircleHelper and GFX_DrawRoundRect are checked
+ * with canvas_compare over a range of radii, centres and rectangle sizes,
+ * partly off screen. The helper is drawn with every one of the 16 corner
+ * masks. The testdrawcircles and testroundrects scenes of main.c must
+ * then cost fewer SPI bytes.
+ *
+ * @author @btondin
+ * @date 2025
+ */
+
+#include "harness.h"
+#include "canvas.h"
+
+/**
+ * @brief The corner arcs GFX_DrawCircleHelper used to draw: two pixels
+ *        per step for each selected quadrant
+ */
+static void ref_DrawCircleHelper(GFX_t *gfx, void *display, int16_t x0, int16_t y0, int16_t r,
+                                 uint8_t cornername, uint16_t color) {
+    int16_t f = 1 - r, ddF_x = 1, ddF_y = -2 * r, x = 0, y = r;
+
+    while (x < y) {
+        if (f >= 0) {
+            y--;
+            ddF_y += 2;
+            f += ddF_y;
+        }
+        x++;
+        ddF_x += 2;
+        f += ddF_x;
+
+        if (cornername & 0x4) {
+            GFX_DrawPixel(gfx, display, x0 + x, y0 + y, color);
+            GFX_DrawPixel(gfx, display, x0 + y, y0 + x, color);
+        }
+        if (cornername & 0x2) {
+            GFX_DrawPixel(gfx, display, x0 + x, y0 - y, color);
+            GFX_DrawPixel(gfx, display, x0 + y, y0 - x, color);
+        }
+        if (cornername & 0x8) {
+            GFX_DrawPixel(gfx, display, x0 - y, y0 + x, color);
+            GFX_DrawPixel(gfx, display, x0 - x, y0 + y, color);
+        }
+        if (cornername & 0x1) {
+            GFX_DrawPixel(gfx, display, x0 - y, y0 - x, color);
+            GFX_DrawPixel(gfx, display, x0 - x, y0 - y, color);
+        }
+    }
+}
+
+/**
+ * @brief The circle GFX_DrawCircle used to draw: eight pixels per step
+ */
+static void ref_DrawCircle(GFX_t *gfx, void *display, int16_t x0, int16_t y0, int16_t r, uint16_t color) {
+    if (!GFX_BoxVisible(gfx, x0 - r, y0 - r, x0 + r, y0 + r)) {
+        return;
+    }
+    GFX_DrawPixel(gfx, display, x0, y0 + r, color);
+    GFX_DrawPixel(gfx, display, x0, y0 - r, color);
+    GFX_DrawPixel(gfx, display, x0 + r, y0, color);
+    GFX_DrawPixel(gfx, display, x0 - r, y0, color);
+    ref_DrawCircleHelper(gfx, display, x0, y0, r, 0xF, color);
+}
+
+/**
+ * @brief The round rect GFX_DrawRoundRect used to draw: four sides and
+ *        four separate corner arcs
+ */
+static void ref_DrawRoundRect(GFX_t *gfx, void *display, int16_t x, int16_t y, int16_t w, int16_t h,
+                              int16_t r, uint16_t color) {
+    int16_t max_radius = ((w < h) ? w : h) / 2;
+
+    if (!GFX_BoxVisible(gfx, x, y, x + w - 1, y + h - 1)) {
+        return;
+    }
+    if (r > max_radius) {
+        r = max_radius;
+    }
+    GFX_DrawFastHLine(gfx, display, x + r, y, w - 2 * r, color);
+    GFX_DrawFastHLine(gfx, display, x + r, y + h - 1, w - 2 * r, color);
+    GFX_DrawFastVLine(gfx, display, x, y + r, h - 2 * r, color);
+    GFX_DrawFastVLine(gfx, display, x + w - 1, y + r, h - 2 * r, color);
+    ref_DrawCircleHelper(gfx, display, x + r, y + r, r, 1, color);
+    ref_DrawCircleHelper(gfx, display, x + w - r - 1, y + r, r, 2, color);
+    ref_DrawCircleHelper(gfx, display, x + w - r - 1, y + h - r - 1, r, 4, color);
+    ref_DrawCircleHelper(gfx, display, x + r, y + h - r - 1, r, 8, color);
+}
+
+typedef void (*circle_fn)(GFX_t *, void *, int16_t, int16_t, int16_t, uint16_t);
+typedef void (*round_rect_fn)(GFX_t *, void *, int16_t, int16_t, int16_t, int16_t, int16_t, uint16_t);
+
+/**
+ * @brief One circle from args (x0, y0, r)
+ */
+static void draw_circle(GFX_t *gfx, bool ref, const int16_t *v) {
+    (ref ? ref_DrawCircle : GFX_DrawCircle)(gfx, NULL, v[0], v[1], v[2], 1);
+}
+
+/**
+ * @brief One set of corner arcs from args (x0, y0, r, cornername)
+ */
+static void draw_helper(GFX_t *gfx, bool ref, const int16_t *v) {
+    (ref ? ref_DrawCircleHelper : GFX_DrawCircleHelper)(gfx, NULL, v[0], v[1], v[2], (uint8_t)v[3], 1);
+}
+
+/**
+ * @brief One round rect from args (x, y, w, h, r)
+ */
+static void draw_round_rect(GFX_t *gfx, bool ref, const int16_t *v) {
+    (ref ? ref_DrawRoundRect : GFX_DrawRoundRect)(gfx, NULL, v[0], v[1], v[2], v[3], v[4], 1);
+}
+
+/**
+ * @brief testdrawcircles and testroundrects from main.c, through the driver
+ */
+static void scenes(bool ref) {
+    circle_fn circle = ref ? ref_DrawCircle : GFX_DrawCircle;
+    round_rect_fn round_rect = ref ? ref_DrawRoundRect : GFX_DrawRoundRect;
+    GFX_t *g = &oled.gfx;
+    uint16_t color = 100;
+    int16_t x, y, w, h;
+    int i, t;
+
+    for (x = 0; x < g->width + 10; x += 20) {
+        for (y = 0; y < g->height + 10; y += 20) {
+            circle(g, &oled, x, y, 10, SSD1331_WHITE);
+        }
+    }
+    for (t = 0; t <= 4; t++) {
+        x = 0;
+        y = 0;
+        w = g->width;
+        h = g->height;
+        for (i = 0; i <= 8; i++) {
+            round_rect(g, &oled, x, y, w, h, 5, color);
+            x += 2;
+            y += 3;
+            w -= 4;
+            h -= 6;
+            color += 1100;
+        }
+        color += 100;
+    }
+}
+
+int main(void) {
+    GFX_t gfx;
+    int hooks, clip, r, a, w, h;
+
+    canvas_init(&gfx);
+
+    for (hooks = 1; hooks >= 0; hooks--) {
+        canvas_diff_t diff = {0};
+
+        if (!hooks) {
+            canvas_pixels_only(&gfx);
+        }
+        for (clip = 0; clip < 2; clip++) {
+            if (clip) {
+                GFX_SetClipRect(&gfx, 10, 5, 40, 30);
+            } else {
+                GFX_ResetClip(&gfx);
+            }
+            for (r = 0; r <= 40; r++) {
+                for (a = 0; a < 16; a++) {
+                    int16_t cx = (int16_t)(10 + a * 3), cy = (int16_t)(35 - a * 2);
+                    int16_t v[5] = {cx, cy, (int16_t)r, (int16_t)a};
+
+                    canvas_compare(&gfx, "circle", draw_circle, v, 3, &diff);
+                    canvas_compare(&gfx, "helper", draw_helper, v, 4, &diff);
+                    for (w = 0; w < 60; w += 3) {
+                        for (h = 0; h < 60; h += 5) {
+                            v[0] = (int16_t)(cx - 20);
+                            v[1] = (int16_t)(cy - 20);
+                            v[2] = (int16_t)w;
+                            v[3] = (int16_t)h;
+                            v[4] = (int16_t)r;
+                            canvas_compare(&gfx, "round rect", draw_round_rect, v, 5, &diff);
+                        }
+                    }
+                }
+            }
+        }
+        canvas_report(hooks ? "outlines with span hooks" : "outlines pixel by pixel", &diff);
+        if (hooks) {
+            CHECK(diff.calls < diff.ref_calls, "spans took %lu calls, pixel steps %lu", diff.calls, diff.ref_calls);
+        }
+    }
+
+    harness_begin(0);
+    harness_compare_scene("circles and round rects", scenes);
+
+    return harness_end("circle");
+}
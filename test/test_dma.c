@@ -0,0 +1,253 @@
+/**
+ * @file test_dma.c
+ * @brief Pixel streaming through SSD1331_FillRect_Fast, the RGB bitmap
+ *        functions and SSD1331_DrawScanlines
+ *
+ * Checks the panel contents against an image kept by the test. In the
+ * DMA build it also checks every burst the driver hands to DMA1: none is
+ * larger than the 11-bit SPI1TCNT, SPI1TCNT holds the burst size when
+ * the burst starts, fills reload a 2-byte source, and row jobs send one
+ * staged row per burst. Jobs are started back to back, mixed with
+ * blocking drawing and the scanline pipeline, without waiting in
+ * between, so a job that starts before the previous one has drained or
+ * that stages a row into a buffer still on the wire shows up as wrong
+ * pixels or as a protocol violation. The scanline overlap is reported:
+ * some lines must be rendered while the previous one is on the wire in
+ * the DMA and queue builds, and none in the blocking build.
+ *
+ * @author @btondin
+ * @date 2025
+ */
+
+#include "harness.h"
+#include <stdlib.h>
+#include <string.h>
+
+/** @brief Image the panel should show, in display coordinates (rotation 0) */
+static uint16_t want[SSD1331_HEIGHT][SSD1331_WIDTH];
+
+#ifdef SSD1331_USE_DMA
+/** @brief Completed transfers reported through the DMA callback */
+static volatile unsigned completions;
+
+static void on_complete(void *context) {
+    (*(volatile unsigned *)context)++;
+}
+#endif
+
+static void want_rect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {
+    int16_t i, j;
+
+    for (j = y; j < y + h; j++) {
+        for (i = x; i < x + w; i++) {
+            if (i >= 0 && i < SSD1331_WIDTH && j >= 0 && j < SSD1331_HEIGHT) {
+                want[j][i] = color;
+            }
+        }
+    }
+}
+
+static void want_bitmap(int16_t x, int16_t y, const uint16_t *bitmap, int16_t w, int16_t h) {
+    int16_t i, j;
+
+    for (j = 0; j < h; j++) {
+        for (i = 0; i < w; i++) {
+            if (x + i >= 0 && x + i < SSD1331_WIDTH && y + j >= 0 && y + j < SSD1331_HEIGHT) {
+                want[y + j][x + i] = bitmap[j * w + i];
+            }
+        }
+    }
+}
+
+static unsigned compare(const char *what) {
+    unsigned bad = 0;
+    int r, c;
+
+    harness_settle();
+    for (r = 0; r < SSD1331_HEIGHT; r++) {
+        for (c = 0; c < SSD1331_WIDTH; c++) {
+            if (panel_ram[r][c] != want[r][c]) {
+                if (bad++ == 0) {
+                    printf("%s: pixel (%d,%d) is %04x, want %04x\n", what, c, r, panel_ram[r][c], want[r][c]);
+                }
+            }
+        }
+    }
+    CHECK(bad == 0, "%s: %u pixels differ", what, bad);
+    return bad;
+}
+
+#ifdef SSD1331_USE_DMA
+/**
+ * @brief Check the bursts logged since 'first' and return the bytes they sent
+ * @param first Index of the first burst of the job
+ * @param fill The job repeats a 2-byte pattern
+ * @param row_bytes Bytes per burst of a row job, 0 for other jobs
+ */
+static unsigned long check_bursts(size_t first, bool fill, uint16_t row_bytes) {
+    unsigned long bytes = 0;
+    size_t i;
+
+    for (i = first; i < host_dma_bursts && i < HOST_LOG_MAX; i++) {
+        const host_dma_burst_t *b = &host_dma_log[i];
+
+        CHECK(b->size > 0 && b->size <= 2047, "burst %zu has %u bytes", i, b->size);
+        CHECK(b->size <= SSD1331_DMA_CHUNK, "burst %zu exceeds SSD1331_DMA_CHUNK", i);
+        CHECK(b->tcnt == b->size, "burst %zu started with SPI1TCNT %u for %u bytes", i, b->tcnt, b->size);
+        if (fill) {
+            CHECK(b->ssz == 2, "fill burst %zu reloads after %u source bytes", i, b->ssz);
+        } else {
+            CHECK(b->ssz == b->size, "burst %zu reads %u source bytes for %u", i, b->ssz, b->size);
+        }
+        if (row_bytes) {
+            CHECK(b->size == row_bytes, "row burst %zu has %u bytes, want %u", i, b->size, row_bytes);
+        }
+        bytes += b->size;
+    }
+    return bytes;
+}
+#endif
+
+/**
+ * @brief Scanline renderer: a diagonal colour ramp
+ */
+static void ramp(void *context, int16_t row, uint8_t *line, int16_t w) {
+    int16_t i;
+
+    (void)context;
+    for (i = 0; i < w; i++) {
+        uint16_t color = (uint16_t)((row * 517 + i * 33) ^ 0x5A5A);
+
+        line[2 * i] = color >> 8;
+        line[2 * i + 1] = color & 0xFF;
+    }
+}
+
+int main(void) {
+    static uint16_t bitmap[SSD1331_HEIGHT * SSD1331_WIDTH];
+    static uint8_t bytes[SSD1331_HEIGHT * SSD1331_WIDTH * 2];
+    SSD1331_ScanlineStats_t stats;
+    unsigned long lines = 0, overlapped = 0;
+    size_t first;
+    int t, i;
+
+    srand(1);
+    for (i = 0; i < SSD1331_HEIGHT * SSD1331_WIDTH; i++) {
+        bitmap[i] = (uint16_t)rand();
+        bytes[2 * i] = bitmap[i] >> 8;
+        bytes[2 * i + 1] = bitmap[i] & 0xFF;
+    }
+
+    harness_begin(0);
+#ifdef SSD1331_USE_DMA
+    SSD1331_SetDMACallback(&oled, on_complete, (void *)&completions);
+#endif
+
+    // Full screen fill: 12288 bytes, more than one SPI1TCNT load
+    first = host_dma_bursts;
+    SSD1331_FillRect_Fast(&oled, 0, 0, SSD1331_WIDTH, SSD1331_HEIGHT, 0xF81F);
+    want_rect(0, 0, SSD1331_WIDTH, SSD1331_HEIGHT, 0xF81F);
+    compare("fill screen");
+#ifdef SSD1331_USE_DMA
+    CHECK(check_bursts(first, true, 0) == sizeof(bytes), "fill sent the wrong byte count");
+    CHECK(host_dma_bursts - first == (sizeof(bytes) + SSD1331_DMA_CHUNK - 1) / SSD1331_DMA_CHUNK,
+          "fill took %zu bursts", host_dma_bursts - first);
+    CHECK(completions == 1, "%u completions after one fill", completions);
+#endif
+
+    // Full screen byte bitmap straight from memory
+    first = host_dma_bursts;
+    SSD1331_DrawFastRGBBitmap8(&oled, 0, 0, bytes, SSD1331_WIDTH, SSD1331_HEIGHT);
+    want_bitmap(0, 0, bitmap, SSD1331_WIDTH, SSD1331_HEIGHT);
+    compare("byte bitmap");
+#ifdef SSD1331_USE_DMA
+    SSD1331_FillScreen(&oled, 0);
+    first = host_dma_bursts;
+    SSD1331_DrawFastRGBBitmap8_DMA(&oled, 0, 0, bytes, SSD1331_WIDTH, SSD1331_HEIGHT, SSD1331_DMA_SRC_RAM);
+    compare("byte bitmap, DMA block");
+    CHECK(check_bursts(first, false, 0) == sizeof(bytes), "block job sent the wrong byte count");
+#endif
+
+    // Clipped word bitmaps are staged row by row
+    for (t = 0; t < 40; t++) {
+        int16_t w = (int16_t)(1 + rand() % 120), h = (int16_t)(1 + rand() % 80);
+        int16_t x = (int16_t)(rand() % 140 - 30), y = (int16_t)(rand() % 100 - 20);
+
+        if ((long)w * h > SSD1331_HEIGHT * SSD1331_WIDTH) {
+            h = (int16_t)(SSD1331_HEIGHT * SSD1331_WIDTH / w);
+        }
+        first = host_dma_bursts;
+        SSD1331_DrawFastRGBBitmap16(&oled, x, y, bitmap + t, w, h);
+        want_bitmap(x, y, bitmap + t, w, h);
+        if (compare("word bitmap")) {
+            printf("  x=%d y=%d w=%d h=%d\n", x, y, w, h);
+        }
+#ifdef SSD1331_USE_DMA
+        {
+            int16_t cw = (int16_t)((x + w > SSD1331_WIDTH ? SSD1331_WIDTH : x + w) - (x < 0 ? 0 : x));
+            int16_t ch = (int16_t)((y + h > SSD1331_HEIGHT ? SSD1331_HEIGHT : y + h) - (y < 0 ? 0 : y));
+
+            if (cw > 0 && ch > 0) {
+                CHECK(host_dma_bursts - first == (size_t)ch, "%zu bursts for %d rows", host_dma_bursts - first, ch);
+                check_bursts(first, false, (uint16_t)(cw * 2));
+            }
+        }
+#endif
+    }
+
+    // Jobs back to back, mixed with blocking drawing and scanlines
+    for (t = 0; t < 200; t++) {
+        int16_t w = (int16_t)(1 + rand() % 96), h = (int16_t)(1 + rand() % 64);
+        int16_t x = (int16_t)(rand() % 110 - 10), y = (int16_t)(rand() % 74 - 10);
+        uint16_t color = (uint16_t)rand();
+
+        switch (rand() % 4) {
+            case 0:
+                SSD1331_FillRect_Fast(&oled, x, y, w, h, color);
+                want_rect(x, y, w, h, color);
+                break;
+            case 1:
+                SSD1331_DrawFastRGBBitmap16(&oled, x, y, bitmap + t * 7, w, h);
+                want_bitmap(x, y, bitmap + t * 7, w, h);
+                break;
+            case 2:
+                SSD1331_DrawPixel(&oled, x, y, color);
+                want_rect(x, y, 1, 1, color);
+                break;
+            default:
+                if (x >= 0 && y >= 0 && x + w <= SSD1331_WIDTH && y + h <= SSD1331_HEIGHT) {
+                    static uint8_t line[SSD1331_WIDTH * 2];
+                    int16_t r;
+
+                    SSD1331_DrawScanlines(&oled, x, y, w, h, ramp, NULL, &stats);
+                    CHECK(stats.lines == h, "%u of %d scanlines rendered", stats.lines, h);
+                    lines += stats.lines;
+                    overlapped += stats.overlapped;
+                    for (r = 0; r < h; r++) {
+                        ramp(NULL, (int16_t)(y + r), line, w);
+                        for (i = 0; i < w; i++) {
+                            want[y + r][x + i] = (uint16_t)((line[2 * i] << 8) | line[2 * i + 1]);
+                        }
+                    }
+                }
+                break;
+        }
+    }
+    compare("mixed jobs");
+
+    // Lines rendered while the previous line was still on the wire
+    printf("scanlines: %lu of %lu lines overlapped\n", overlapped, lines);
+    CHECK(lines > 0, "no scanline job was drawn");
+#if defined(SSD1331_USE_DMA) || defined(SSD1331_USE_QUEUE)
+    CHECK(overlapped > 0, "no scanline was rendered while another was sent");
+#else
+    CHECK(overlapped == 0, "%lu scanlines overlapped in the blocking build", overlapped);
+#endif
+#ifdef SSD1331_USE_DMA
+    CHECK(!SSD1331_IsBusy(&oled), "still busy after SSD1331_WaitDMA");
+    CHECK(host_interrupts > 0, "no interrupt ever ran");
+#endif
+
+    (void)first;
+    return harness_end("dma");
+}
@@ -0,0 +1,162 @@
+/**
+ * @file test_line.c
+ * @brief Software lines: run slices draw the pixels of the old
+ *        pixel-stepping Bresenham, with fewer driver calls
+ *
+ * GFX_WriteLine is checked with canvas_compare on random shallow, steep,
+ * axis-aligned and diagonal lines, partly off screen. No pixel may be
+ * written twice. The testlines fan of main.c must then cost fewer SPI
+ * bytes, and GFX_DrawLine must stream every line of the fan the same way.
+ *
+ * @author @btondin
+ * @date 2025
+ */
+
+#include "harness.h"
+#include "canvas.h"
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * @brief The loop GFX_WriteLine used to be: one drawPixel per step
+ */
+static void ref_WriteLine(GFX_t *gfx, void *display, int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint16_t color) {
+    int16_t steep = abs(y1 - y0) > abs(x1 - x0);
+    int16_t dx, dy, err, ystep;
+
+    if (steep) { GFX_Swap(&x0, &y0); GFX_Swap(&x1, &y1); }
+    if (x0 > x1) { GFX_Swap(&x0, &x1); GFX_Swap(&y0, &y1); }
+
+    dx = x1 - x0;
+    dy = abs(y1 - y0);
+    err = dx / 2;
+    ystep = (y0 < y1) ? 1 : -1;
+
+    for (; x0 <= x1; x0++) {
+        if (steep) {
+            GFX_DrawPixel(gfx, display, y0, x0, color);
+        } else {
+            GFX_DrawPixel(gfx, display, x0, y0, color);
+        }
+        err -= dy;
+        if (err < 0) {
+            y0 += ystep;
+            err += dx;
+        }
+    }
+}
+
+typedef void (*line_fn)(GFX_t *, void *, int16_t, int16_t, int16_t, int16_t, uint16_t);
+
+/**
+ * @brief One line from args (x0, y0, x1, y1)
+ */
+static void draw_line(GFX_t *gfx, bool ref, const int16_t *v) {
+    (ref ? ref_WriteLine : GFX_WriteLine)(gfx, NULL, v[0], v[1], v[2], v[3], 1);
+}
+
+/**
+ * @brief The fan of lines from testlines in main.c, through the driver
+ */
+static void fan_with(line_fn line) {
+    int16_t x;
+
+    for (x = 0; x < SSD1331_WIDTH; x += 6) {
+        line(&oled.gfx, &oled, 0, 0, x, SSD1331_HEIGHT - 1, SSD1331_WHITE);
+        line(&oled.gfx, &oled, 0, SSD1331_HEIGHT - 1, SSD1331_WIDTH - 1,
+             (int16_t)(SSD1331_HEIGHT - 1 - x * 2 / 3), SSD1331_GREEN);
+    }
+}
+
+/**
+ * @brief The fan with the pixel-stepping loop or with GFX_WriteLine
+ */
+static void fan(bool ref) {
+    fan_with(ref ? ref_WriteLine : GFX_WriteLine);
+}
+
+int main(void) {
+    GFX_t gfx;
+    unsigned long twice = 0;
+    int hooks, t, i;
+
+    canvas_init(&gfx);
+    srand(20);
+
+    for (hooks = 1; hooks >= 0; hooks--) {
+        canvas_diff_t diff = {0};
+
+        if (!hooks) {
+            canvas_pixels_only(&gfx);
+        }
+        for (t = 0; t < 100000; t++) {
+            int16_t v[4];
+
+            v[0] = (int16_t)(rand() % 140 - 22);
+            v[1] = (int16_t)(rand() % 100 - 18);
+            v[2] = (int16_t)(rand() % 140 - 22);
+            v[3] = (int16_t)(rand() % 100 - 18);
+            switch (t % 8) {
+                case 0:
+                    v[3] = v[1];                                            // Horizontal
+                    break;
+                case 1:
+                    v[2] = v[0];                                            // Vertical
+                    break;
+                case 2:
+                    v[3] = (int16_t)(v[1] + ((t & 16) ? v[2] - v[0] : v[0] - v[2]));   // Diagonal
+                    break;
+                case 3:
+                    v[2] = (int16_t)(v[0] + rand() % 5 - 2);               // Nearly vertical
+                    break;
+                case 4:
+                    v[3] = (int16_t)(v[1] + rand() % 5 - 2);               // Nearly horizontal
+                    break;
+                default:
+                    break;
+            }
+            if (t % 3 == 0) {
+                GFX_SetClipRect(&gfx, 5, 7, 60, 40);
+            } else {
+                GFX_ResetClip(&gfx);
+            }
+
+            canvas_compare(&gfx, "line", draw_line, v, 4, &diff);
+            for (i = 0; i < CANVAS_W * CANVAS_H; i++) {
+                if (canvas_hits[i / CANVAS_W][i % CANVAS_W] > 1 && twice++ < 5) {
+                    printf("(%d,%d)-(%d,%d) writes (%d,%d) twice\n", v[0], v[1], v[2], v[3],
+                           i % CANVAS_W, i / CANVAS_W);
+                }
+            }
+        }
+        canvas_report(hooks ? "lines with span hooks" : "lines pixel by pixel", &diff);
+        if (hooks) {
+            CHECK(diff.calls < diff.ref_calls, "run slices took %lu calls, pixel steps %lu",
+                  diff.calls, diff.ref_calls);
+        } else {
+            CHECK(diff.calls == diff.ref_calls, "without span hooks: %lu calls, want %lu",
+                  diff.calls, diff.ref_calls);
+        }
+    }
+    CHECK(twice == 0, "%lu pixels written more than once", twice);
+
+    // Through the driver: GFX_WriteLine bypasses the hardware line command
+    harness_begin(0);
+    {
+        static uint16_t frame[PANEL_ROWS][PANEL_COLS];
+        panel_stats_t new_st = harness_compare_scene("testlines fan", fan), st;
+
+        // With the recommended engine wait, every line on the panel is
+        // streamed sooner than the hardware line command would finish
+        memcpy(frame, panel_ram, sizeof(frame));
+        SSD1331_FillScreen(&oled, 0);
+        harness_settle();
+        fan_with(GFX_DrawLine);
+        st = harness_settle();
+        CHECK(memcmp(frame, panel_ram, sizeof(frame)) == 0, "GFX_DrawLine gave a different frame");
+        CHECK(st.cmd_bytes == new_st.cmd_bytes && st.data_bytes == new_st.data_bytes,
+              "GFX_DrawLine sent %lu command bytes, run slices %lu", st.cmd_bytes, new_st.cmd_bytes);
+    }
+
+    return harness_end("line");
+}
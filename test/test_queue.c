@@ -0,0 +1,217 @@
+/**
+ * @file test_queue.c
+ * @brief Interrupt-driven draw queue: background sending, callbacks and
+ *        the full-queue policy
+ *
+ * Built with SSD1331_USE_QUEUE, with and without SSD1331_QUEUE_DROP.
+ * Checks that drawing calls return while their bytes are still being
+ * sent, that queued callbacks run from the interrupt handler exactly
+ * when every byte queued before them is on the wire, that byte bitmaps
+ * are copied into the queue rather than read later from the caller's
+ * buffer, and that a full queue either blocks until there is room or
+ * drops whole packets without ever putting a pixel in the wrong place.
+ *
+ * @author @btondin
+ * @date 2025
+ */
+
+#include "harness.h"
+#include <stdlib.h>
+#include <string.h>
+
+/** @brief Bitmaps queued with a callback after each */
+#define JOBS        4
+
+/** @brief Side of each bitmap in pixels, small enough for all jobs to fit the queue */
+#define JOB_SIZE    4
+
+/**
+ * @brief What a queued callback saw when it ran
+ */
+typedef struct {
+    bool ran;
+    bool in_interrupt;
+    size_t captured;    ///< Bytes on the wire when it ran
+    unsigned order;     ///< Callbacks that ran before it
+} job_t;
+
+static job_t jobs[JOBS];
+static unsigned callbacks;
+
+static void on_job(void *context) {
+    job_t *job = context;
+
+    job->ran = true;
+    job->in_interrupt = host_in_interrupt();
+    job->captured = host_captured;
+    job->order = callbacks++;
+}
+
+/**
+ * @brief Colour the random pixel test draws at (x, y), never black
+ */
+static uint16_t pixel_color(int16_t x, int16_t y) {
+    return (uint16_t)(((x * 131 + y * 71) & 0x7FFF) | 0x8000);
+}
+
+int main(void) {
+    static uint16_t bitmap[JOB_SIZE * JOB_SIZE];
+    static uint16_t order[SSD1331_WIDTH * SSD1331_HEIGHT];
+    unsigned long spins = 0, drawn = 0, misplaced = 0;
+    size_t sent;
+    int i, r, c;
+#ifdef SSD1331_QUEUE_DROP
+    int pad;
+#endif
+
+    for (i = 0; i < JOB_SIZE * JOB_SIZE; i++) {
+        bitmap[i] = (uint16_t)(i * 1021);
+    }
+
+    harness_begin(0);
+
+    // A full screen fill returns long before its 12288 bytes are out
+    SSD1331_FillRect_Fast(&oled, 0, 0, SSD1331_WIDTH, SSD1331_HEIGHT, SSD1331_CYAN);
+    sent = host_captured;
+    CHECK(SSD1331_IsBusy(&oled), "queue idle right after a full screen fill");
+    while (SSD1331_IsBusy(&oled)) {
+        spins++;
+    }
+    CHECK(sent < SSD1331_WIDTH * SSD1331_HEIGHT, "%zu bytes sent before the fill returned", sent);
+    CHECK(spins > 0, "the main program never ran while the fill was sent");
+    harness_settle();
+    for (r = 0; r < PANEL_ROWS; r++) {
+        for (c = 0; c < PANEL_COLS; c++) {
+            CHECK(panel_ram[r][c] == SSD1331_CYAN, "fill missed (%d,%d)", c, r);
+            if (panel_ram[r][c] != SSD1331_CYAN) {
+                r = PANEL_ROWS;
+                break;
+            }
+        }
+    }
+
+    // Each callback runs once the bitmap queued before it has been sent:
+    // one window (6 command bytes) and JOB_SIZE * JOB_SIZE pixels
+    for (i = 0; i < JOBS; i++) {
+        SSD1331_DrawFastRGBBitmap16(&oled, (int16_t)(i * 20), (int16_t)(i * 10), bitmap, JOB_SIZE, JOB_SIZE);
+        CHECK(SSD1331_QueueCallback(&oled, on_job, &jobs[i]), "callback %d dropped", i);
+    }
+    SSD1331_Flush(&oled);
+    CHECK(callbacks == JOBS, "%u callbacks ran before SSD1331_Flush returned", callbacks);
+    for (i = 0; i < JOBS; i++) {
+        CHECK(jobs[i].ran && jobs[i].order == (unsigned)i, "callback %d ran out of order", i);
+        CHECK(jobs[i].in_interrupt, "callback %d ran outside the interrupt handler", i);
+        CHECK(jobs[i].captured == (size_t)(i + 1) * (6 + JOB_SIZE * JOB_SIZE * 2),
+              "callback %d ran with %zu bytes sent", i, jobs[i].captured);
+    }
+    harness_settle();
+
+    // Byte bitmaps are copied into the queue: the caller may reuse the
+    // buffer as soon as the call returns, even while the rows are queued
+    {
+        uint8_t rows[4 * 2];
+        unsigned long wrong = 0;
+
+        SSD1331_FillScreen(&oled, 0);
+        harness_settle();
+        for (r = 0; r < 16; r++) {
+            for (c = 0; c < 4; c++) {
+                rows[2 * c] = (uint8_t)(0x80 | r);
+                rows[2 * c + 1] = (uint8_t)c;
+            }
+            SSD1331_DrawFastRGBBitmap8(&oled, 40, (int16_t)(20 + r), rows, 4, 1);
+            memset(rows, 0, sizeof(rows));
+        }
+        harness_settle();
+        for (r = 0; r < 16; r++) {
+            for (c = 0; c < 4; c++) {
+                uint16_t got = panel_ram[20 + r][40 + c];
+
+#ifdef SSD1331_QUEUE_DROP
+                if (got == 0) {
+                    continue;               // Dropped with a full queue
+                }
+#endif
+                if (got != (uint16_t)(((0x80 | r) << 8) | c)) {
+                    wrong++;
+                }
+            }
+        }
+        CHECK(wrong == 0, "%lu bitmap pixels changed after the buffer was reused", wrong);
+    }
+
+    // Far more pixels than the queue holds, each drawn once in random order
+    SSD1331_FillScreen(&oled, 0);
+    harness_settle();
+    for (i = 0; i < SSD1331_WIDTH * SSD1331_HEIGHT; i++) {
+        order[i] = (uint16_t)i;
+    }
+    srand(5);
+    for (i = SSD1331_WIDTH * SSD1331_HEIGHT - 1; i > 0; i--) {
+        int j = rand() % (i + 1);
+        uint16_t t = order[i];
+
+        order[i] = order[j];
+        order[j] = t;
+    }
+    for (i = 0; i < SSD1331_WIDTH * SSD1331_HEIGHT; i++) {
+        int16_t x = (int16_t)(order[i] % SSD1331_WIDTH), y = (int16_t)(order[i] / SSD1331_WIDTH);
+
+        SSD1331_DrawPixel(&oled, x, y, pixel_color(x, y));
+    }
+    harness_settle();
+    for (r = 0; r < PANEL_ROWS; r++) {
+        for (c = 0; c < PANEL_COLS; c++) {
+            if (panel_ram[r][c] == pixel_color((int16_t)c, (int16_t)r)) {
+                drawn++;
+            } else if (panel_ram[r][c] != 0) {
+                misplaced++;
+            }
+        }
+    }
+    CHECK(misplaced == 0, "%lu pixels landed in the wrong place", misplaced);
+#ifdef SSD1331_QUEUE_DROP
+    CHECK(oled.queue_dropped > 0, "a full queue never dropped a packet");
+    CHECK(drawn > 0, "no pixel survived a full queue");
+#else
+    CHECK(oled.queue_dropped == 0, "%u packets dropped without SSD1331_QUEUE_DROP", oled.queue_dropped);
+    CHECK(drawn == SSD1331_WIDTH * SSD1331_HEIGHT, "only %lu pixels drawn", drawn);
+#endif
+
+#ifdef SSD1331_QUEUE_DROP
+    // With interrupts held off the queue fills up deterministically. Each
+    // padding length makes a different packet the first one that does
+    // not fit, so some window command is dropped while the pixel data
+    // queued after it would still fit.
+    for (pad = 1; pad <= 12; pad++) {
+        static const uint8_t nops[12] = {
+            SSD1331_CMD_NOP, SSD1331_CMD_NOP, SSD1331_CMD_NOP, SSD1331_CMD_NOP,
+            SSD1331_CMD_NOP, SSD1331_CMD_NOP, SSD1331_CMD_NOP, SSD1331_CMD_NOP,
+            SSD1331_CMD_NOP, SSD1331_CMD_NOP, SSD1331_CMD_NOP, SSD1331_CMD_NOP
+        };
+
+        SSD1331_FillScreen(&oled, 0);
+        harness_settle();
+        INTCON0bits.GIE = 0;
+        SSD1331_WriteCommands(&oled, nops, (uint8_t)pad);
+        for (i = 0; i < 40; i++) {
+            int16_t x = (int16_t)(i * 7 % SSD1331_WIDTH), y = (int16_t)(i * 5 % SSD1331_HEIGHT);
+
+            SSD1331_DrawPixel(&oled, x, y, pixel_color(x, y));
+        }
+        INTCON0bits.GIE = 1;
+        harness_settle();
+        misplaced = 0;
+        for (r = 0; r < PANEL_ROWS; r++) {
+            for (c = 0; c < PANEL_COLS; c++) {
+                if (panel_ram[r][c] != 0 && panel_ram[r][c] != pixel_color((int16_t)c, (int16_t)r)) {
+                    misplaced++;
+                }
+            }
+        }
+        CHECK(misplaced == 0, "%d padding bytes: %lu pixels landed in the wrong place", pad, misplaced);
+    }
+#endif
+
+    return harness_end("queue");
+}
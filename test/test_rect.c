@@ -0,0 +1,118 @@
+/**
+ * @file test_rect.c
+ * @brief Rectangle outlines: four spans or one draw-rectangle command
+ *
+ * Draws random outlines, partly off screen and with and without a clip
+ * rectangle, in every rotation, and checks the panel against an image
+ * kept by the test. Built once with the recommended engine waits, where
+ * every outline must be streamed, and once with SSD1331_HW_FILL_MIN_US
+ * lowered as for a timed panel, where every fully visible outline of
+ * SSD1331_HW_OUTLINE_MIN pixels or more must be a single command.
+ *
+ * @author @btondin
+ * @date 2025
+ */
+
+#include "harness.h"
+#include <stdlib.h>
+#include <string.h>
+
+/** @brief Image the panel should show, in GDDRAM order */
+static uint16_t want[PANEL_ROWS][PANEL_COLS];
+
+/**
+ * @brief Record a pixel given in the coordinates of the current rotation
+ */
+static void want_pixel(int16_t x, int16_t y, uint16_t color) {
+    const GFX_Rect_t *clip = &oled.gfx.clip;
+
+    if (x < clip->x0 || y < clip->y0 || x > clip->x1 || y > clip->y1) {
+        return;
+    }
+    if (oled.rotation & 1) {
+        want[x][y] = color;
+    } else {
+        want[y][x] = color;
+    }
+}
+
+static void want_outline(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {
+    int16_t i;
+
+    for (i = 0; i < w; i++) {
+        want_pixel(x + i, y, color);
+        want_pixel(x + i, y + h - 1, color);
+    }
+    for (i = 0; i < h; i++) {
+        want_pixel(x, y + i, color);
+        want_pixel(x + w - 1, y + i, color);
+    }
+}
+
+int main(void) {
+    unsigned long engine = 0, expected = 0, bad = 0;
+    uint8_t rot;
+    int t, i;
+
+    srand(9);
+    harness_begin(0);
+
+    for (rot = 0; rot < 4; rot++) {
+        SSD1331_SetRotation(&oled, rot);
+        SSD1331_FillScreen(&oled, 0);
+        harness_settle();
+        memset(want, 0, sizeof(want));
+
+        for (t = 0; t < 300; t++) {
+            int16_t w = (int16_t)(1 + rand() % oled.gfx.width), h = (int16_t)(1 + rand() % oled.gfx.height);
+            int16_t x = (int16_t)(rand() % (oled.gfx.width + 20) - 10 - ((t & 1) ? 0 : w / 2));
+            int16_t y = (int16_t)(rand() % (oled.gfx.height + 20) - 10 - ((t & 1) ? 0 : h / 2));
+            uint16_t color = (uint16_t)(rand() | 1);
+            const GFX_Rect_t *clip = &oled.gfx.clip;
+            panel_stats_t st;
+
+            if (t % 5 == 0) {
+                GFX_SetClipRect(&oled.gfx, 6, 4, oled.gfx.width - 15, oled.gfx.height - 10);
+            } else {
+                GFX_ResetClip(&oled.gfx);
+            }
+            if (t % 3 == 0) {
+                // Fully visible, so only the size decides
+                x = (int16_t)(clip->x0 + rand() % (clip->x1 - clip->x0 + 1));
+                y = (int16_t)(clip->y0 + rand() % (clip->y1 - clip->y0 + 1));
+                w = (int16_t)(1 + rand() % (clip->x1 - x + 1));
+                h = (int16_t)(1 + rand() % (clip->y1 - y + 1));
+            }
+
+            GFX_DrawRect(&oled.gfx, &oled, x, y, w, h, color);
+            want_outline(x, y, w, h, color);
+            st = harness_settle();
+            if (st.cmd_bytes > 0 && st.data_bytes == 0) {
+                engine++;
+            }
+            if (x >= clip->x0 && y >= clip->y0 && x + w - 1 <= clip->x1 && y + h - 1 <= clip->y1 &&
+                (w + h) * 2 >= SSD1331_HW_OUTLINE_MIN) {
+                expected++;
+            }
+        }
+        GFX_ResetClip(&oled.gfx);
+
+        for (i = 0; i < PANEL_ROWS * PANEL_COLS; i++) {
+            if (panel_ram[i / PANEL_COLS][i % PANEL_COLS] != want[i / PANEL_COLS][i % PANEL_COLS] && bad++ == 0) {
+                printf("rotation %u: GDDRAM (%d,%d) is %04x, want %04x\n", rot, i % PANEL_COLS, i / PANEL_COLS,
+                       panel_ram[i / PANEL_COLS][i % PANEL_COLS], want[i / PANEL_COLS][i % PANEL_COLS]);
+            }
+        }
+    }
+
+    CHECK(bad == 0, "%lu pixels differ", bad);
+    CHECK(engine == expected, "%lu outlines drawn by the engine, want %lu", engine, expected);
+#if SSD1331_HW_OUTLINE_MIN > 2 * (SSD1331_WIDTH + SSD1331_HEIGHT)
+    CHECK(engine == 0, "%lu outlines drawn by the engine with the recommended wait", engine);
+#else
+    CHECK(engine > 0, "no outline was drawn by the engine");
+#endif
+    printf("%lu of %d outlines drawn by the engine\n", engine, 4 * 300);
+
+    return harness_end("rect");
+}
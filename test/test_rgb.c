@@ -0,0 +1,178 @@
+/**
+ * @file test_rgb.c
+ * @brief Dithered true-colour streaming with SSD1331_WriteRGB888 and
+ *        SSD1331_WriteRGBPlanes
+ *
+ * Random images are streamed into random windows in every rotation, as
+ * one call per row, as a single call for the whole window and as colour
+ * planes, and must give the same GDDRAM as drawing each pixel with the
+ * dither computed here from GFX_Bayer. The dither must keep the average of a
+ * flat field exact and saturate instead of wrapping near white. Full
+ * frames are then timed against the scalar SSD1331_Color565 and
+ * SSD1331_WritePixels loop.
+ *
+ * @author @btondin
+ * @date 2025
+ */
+
+#include "harness.h"
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/** @brief Frames per timed run */
+#define BENCH_FRAMES    50
+
+/**
+ * @brief The dithered RGB565 colour of a true-colour pixel at (x, y)
+ */
+static uint16_t dither(uint8_t r, uint8_t g, uint8_t b, int16_t x, int16_t y) {
+    int t = GFX_Bayer[y & 3][x & 3];
+    int r5 = (r + t / 2) >> 3, g6 = (g + t / 4) >> 2, b5 = (b + t / 2) >> 3;
+
+    if (r5 > 31) r5 = 31;
+    if (g6 > 63) g6 = 63;
+    if (b5 > 31) b5 = 31;
+    return (uint16_t)((r5 << 11) | (g6 << 5) | b5);
+}
+
+static void clear_screen(uint8_t rotation) {
+    SSD1331_SetRotation(&oled, rotation);
+    SSD1331_FillScreen(&oled, 0);
+    harness_settle();
+}
+
+static double seconds(void) {
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+int main(void) {
+    static uint8_t img[SSD1331_WIDTH * SSD1331_WIDTH * 3];
+    static uint8_t planes[3][SSD1331_WIDTH * SSD1331_WIDTH];
+    static uint16_t want[PANEL_ROWS][PANEL_COLS];
+    static uint16_t row[SSD1331_WIDTH];
+    unsigned long differ = 0, flat = 0;
+    double scalar = 0, dithered = 0, t0;
+    int t, i, j, v, f;
+
+    harness_begin(0);
+    srand(25);
+
+    for (t = 0; t < 1500; t++) {
+        uint8_t rot = (uint8_t)(t & 3);
+        int16_t W = (rot & 1) ? SSD1331_HEIGHT : SSD1331_WIDTH, H = (rot & 1) ? SSD1331_WIDTH : SSD1331_HEIGHT;
+        int16_t w = (int16_t)(rand() % W + 1), h = (int16_t)(rand() % H + 1);
+        int16_t x = (int16_t)(rand() % (W - w + 1)), y = (int16_t)(rand() % (H - h + 1));
+
+        // Every eighth image sits near white, where the dither must saturate
+        for (i = 0; i < w * h * 3; i++) {
+            img[i] = (uint8_t)((t & 8) ? 255 - rand() % 8 : rand());
+            planes[i % 3][i / 3] = img[i];
+        }
+
+        clear_screen(rot);
+        for (j = 0; j < h; j++) {
+            for (i = 0; i < w; i++) {
+                const uint8_t *p = &img[(j * w + i) * 3];
+
+                GFX_DrawPixel(&oled.gfx, &oled, x + i, y + j, dither(p[0], p[1], p[2], x + i, y + j));
+            }
+        }
+        harness_settle();
+        memcpy(want, panel_ram, sizeof(want));
+
+        clear_screen(rot);
+        SSD1331_SetAddrWindow(&oled, x, y, w, h);
+        switch (t % 3) {
+            case 0:
+                for (j = 0; j < h; j++) {
+                    SSD1331_WriteRGB888(&oled, &img[j * w * 3], w);
+                }
+                break;
+            case 1:
+                SSD1331_WriteRGB888(&oled, img, (uint16_t)(w * h));
+                break;
+            default:
+                for (j = 0; j < h; j++) {
+                    SSD1331_WriteRGBPlanes(&oled, &planes[0][j * w], &planes[1][j * w], &planes[2][j * w], w);
+                }
+                break;
+        }
+        harness_settle();
+        if (memcmp(want, panel_ram, sizeof(want)) != 0 && differ++ < 5) {
+            printf("rotation %u, %s: %dx%d at (%d,%d) differs\n", rot,
+                   (t % 3 == 0) ? "rows" : (t % 3 == 1) ? "one call" : "planes", w, h, x, y);
+        }
+    }
+    CHECK(differ == 0, "%lu of 1500 images differ from the per-pixel dither", differ);
+
+    // A flat field keeps its average: each 4x4 tile the driver sends means
+    // exactly v / 8 (v / 4 for green), and the levels near white saturate
+    clear_screen(0);
+    for (v = 0; v < 256; v++) {
+        int sr = 0, sg = 0;
+
+        memset(img, v, 16 * 3);
+        SSD1331_SetAddrWindow(&oled, 0, 0, 4, 4);
+        SSD1331_WriteRGB888(&oled, img, 16);
+        harness_settle();
+        for (j = 0; j < 4; j++) {
+            for (i = 0; i < 4; i++) {
+                sr += panel_ram[j][i] >> 11;
+                sg += (panel_ram[j][i] >> 5) & 0x3F;
+            }
+        }
+        if ((v < 248) ? (sr != v * 2) : (sr != 31 * 16)) {
+            flat++;
+        }
+        if ((v < 252) ? (sg != v * 4) : (sg != 63 * 16)) {
+            flat++;
+        }
+    }
+    CHECK(flat == 0, "%lu grey levels lose their average", flat);
+
+    // Full frames: the scalar conversion loop against the dithered writer.
+    // Both times include the simulated SPI1, so equal rates mean the
+    // dither costs nothing next to sending the bytes
+    clear_screen(0);
+    for (j = 0; j < SSD1331_HEIGHT; j++) {
+        for (i = 0; i < SSD1331_WIDTH; i++) {
+            uint8_t *p = &img[(j * SSD1331_WIDTH + i) * 3];
+
+            p[0] = (uint8_t)(i * 2);
+            p[1] = (uint8_t)(j * 4);
+            p[2] = (uint8_t)(i + j);
+        }
+    }
+    for (f = 0; f < BENCH_FRAMES; f++) {
+        t0 = seconds();
+        SSD1331_SetAddrWindow(&oled, 0, 0, SSD1331_WIDTH, SSD1331_HEIGHT);
+        for (j = 0; j < SSD1331_HEIGHT; j++) {
+            for (i = 0; i < SSD1331_WIDTH; i++) {
+                const uint8_t *p = &img[(j * SSD1331_WIDTH + i) * 3];
+
+                row[i] = SSD1331_Color565(p[0], p[1], p[2]);
+            }
+            SSD1331_WritePixels(&oled, row, SSD1331_WIDTH);
+        }
+        scalar += seconds() - t0;
+        harness_settle();
+
+        t0 = seconds();
+        SSD1331_SetAddrWindow(&oled, 0, 0, SSD1331_WIDTH, SSD1331_HEIGHT);
+        for (j = 0; j < SSD1331_HEIGHT; j++) {
+            SSD1331_WriteRGB888(&oled, &img[j * SSD1331_WIDTH * 3], SSD1331_WIDTH);
+        }
+        dithered += seconds() - t0;
+        harness_settle();
+    }
+    printf("scalar Color565 + WritePixels: %6.1f Mpx/s\n",
+           BENCH_FRAMES * SSD1331_WIDTH * SSD1331_HEIGHT / scalar / 1e6);
+    printf("WriteRGB888, dithered:         %6.1f Mpx/s\n",
+           BENCH_FRAMES * SSD1331_WIDTH * SSD1331_HEIGHT / dithered / 1e6);
+
+    return harness_end("rgb");
+}
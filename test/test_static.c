@@ -0,0 +1,178 @@
+/**
+ * @file test_static.c
+ * @brief Byte stream of the GFX layer, for comparing driver bindings
+ *
+ * Runs a fixed workload through every GFX drawing function, in all four
+ * rotations and with clip rectangles, and writes each byte the panel
+ * receives (with its D/C level) to <program>.stream. It is built once
+ * with the GFX_t function pointers and once with GFX_DRIVER_SSD1331;
+ * CTest then requires both files to be identical, so the static binding
+ * calls exactly the driver functions the hooks would have.
+ *
+ * @author @btondin
+ * @date 2025
+ */
+
+#include "harness.h"
+#include <stdlib.h>
+#include <string.h>
+
+/** @brief Where the captured traffic goes */
+static FILE *stream;
+
+/** @brief Bytes written to the stream so far */
+static unsigned long streamed;
+
+/**
+ * @brief Append the captured traffic to the stream and decode it
+ */
+static void scene(const char *name) {
+    size_t i;
+
+    host_drain();
+    for (i = 0; i < host_captured; i++) {
+        if (!host_capture[i].cs) {
+            fputc(host_capture[i].data, stream);
+            fputc(host_capture[i].dc, stream);
+            streamed++;
+        }
+    }
+    harness_settle();
+    fprintf(stream, "%s %08x\n", name, (unsigned)panel_hash());
+}
+
+static int16_t rnd(int16_t lo, int16_t hi) {
+    return (int16_t)(lo + rand() % (hi - lo + 1));
+}
+
+static void shapes(void) {
+    GFX_t *g = &oled.gfx;
+    int16_t w = g->width, h = g->height;
+    int i;
+
+    for (i = 0; i < 12; i++) {
+        uint16_t c = (uint16_t)rand();
+
+        GFX_DrawPixel(g, &oled, rnd(-2, w), rnd(-2, h), c);
+        GFX_DrawLine(g, &oled, rnd(-20, w + 20), rnd(-20, h + 20), rnd(-20, w + 20), rnd(-20, h + 20), c);
+        GFX_WriteLine(g, &oled, rnd(0, w - 1), rnd(0, h - 1), rnd(0, w - 1), rnd(0, h - 1), c ^ 0xFFFF);
+        GFX_DrawFastHLine(g, &oled, rnd(-10, w), rnd(-2, h), rnd(1, w), c);
+        GFX_DrawFastVLine(g, &oled, rnd(-2, w), rnd(-10, h), rnd(1, h), c);
+        GFX_DrawRect(g, &oled, rnd(-10, w), rnd(-10, h), rnd(1, w), rnd(1, h), c);
+        GFX_FillRect(g, &oled, rnd(-10, w), rnd(-10, h), rnd(1, 30), rnd(1, 30), c);
+    }
+    scene("lines and rects");
+
+    for (i = 0; i < 6; i++) {
+        uint16_t c = (uint16_t)rand();
+        int16_t x = rnd(-5, w + 5), y = rnd(-5, h + 5), r = rnd(0, 30);
+
+        GFX_DrawCircle(g, &oled, x, y, r, c);
+        GFX_FillCircle(g, &oled, rnd(0, w), rnd(0, h), rnd(0, 20), c ^ 0x5555);
+        GFX_DrawCircleHelper(g, &oled, x, y, r, (uint8_t)rnd(1, 15), c);
+        GFX_FillCircleHelper(g, &oled, x, y, r, (uint8_t)rnd(1, 3), rnd(0, 10), c);
+        GFX_DrawEllipse(g, &oled, x, y, rnd(0, 40), rnd(0, 30), c);
+        GFX_FillEllipse(g, &oled, rnd(0, w), rnd(0, h), rnd(0, 20), rnd(0, 15), c ^ 0x0F0F);
+        GFX_DrawRoundRect(g, &oled, rnd(-5, w), rnd(-5, h), rnd(1, 60), rnd(1, 40), rnd(0, 12), c);
+        GFX_FillRoundRect(g, &oled, rnd(-5, w), rnd(-5, h), rnd(1, 60), rnd(1, 40), rnd(0, 12), c ^ 0xF0F0);
+        GFX_DrawArc(g, &oled, x, y, r, rnd(0, 359), rnd(0, 720), c);
+        GFX_FillArc(g, &oled, rnd(0, w), rnd(0, h), rnd(5, 30), rnd(1, 10), rnd(0, 359), rnd(0, 720), c);
+        GFX_UpdateArc(g, &oled, w / 2, h / 2, 25, 6, rnd(0, 359), rnd(0, 359), c, 0);
+    }
+    scene("curves");
+
+    for (i = 0; i < 8; i++) {
+        uint16_t c = (uint16_t)rand();
+        GFX_Point_t pts[5];
+        int k;
+
+        GFX_DrawTriangle(g, &oled, rnd(-10, w), rnd(-10, h), rnd(-10, w), rnd(-10, h), rnd(-10, w), rnd(-10, h), c);
+        GFX_FillTriangle(g, &oled, rnd(-10, w), rnd(-10, h), rnd(-10, w), rnd(-10, h), rnd(-10, w), rnd(-10, h), c);
+        GFX_FillTriangleTopLeft(g, &oled, rnd(-10, w), rnd(-10, h), rnd(-10, w), rnd(-10, h), rnd(-10, w), rnd(-10, h), c ^ 0xFF);
+        for (k = 0; k < 5; k++) {
+            pts[k].x = rnd(-10, w + 10);
+            pts[k].y = rnd(-10, h + 10);
+        }
+        GFX_FillPolygon(g, &oled, pts, 5, (uint8_t)(i & 1), c ^ 0x1234);
+        GFX_DrawThickLine(g, &oled, rnd(0, w), rnd(0, h), rnd(0, w), rnd(0, h), rnd(1, 6), c);
+        GFX_DrawLineAA(g, &oled, rnd(0, w), rnd(0, h), rnd(0, w), rnd(0, h), c, 0);
+    }
+    scene("polygons");
+
+    {
+        static uint16_t bitmap[20 * 12];
+        GFX_Point_t pts[40];
+        uint16_t colors[40];
+
+        for (i = 0; i < 20 * 12; i++) {
+            bitmap[i] = (uint16_t)rand();
+        }
+        for (i = 0; i < 40; i++) {
+            pts[i].x = rnd(-3, w + 3);
+            pts[i].y = rnd(-3, h + 3);
+            colors[i] = (uint16_t)rand();
+        }
+        GFX_DrawBitmapRGB(g, &oled, rnd(-10, w - 10), rnd(-5, h - 5), bitmap, 20, 12);
+        GFX_DrawPixels(g, &oled, pts, colors, 40);
+        GFX_DrawPixelsInPlace(g, &oled, pts, colors, 40);
+        GFX_FillGradientRect(g, &oled, 2, 3, w - 10, h / 2, 0xF800, 0x001F, (uint8_t)(rand() % 3), true);
+        GFX_FillRadialGradient(g, &oled, 5, h / 2, w - 8, h / 2 - 2, w / 2, h / 2, 30, 0xFFFF, 0x07E0, rand() & 1);
+    }
+    scene("bitmaps and gradients");
+
+    {
+        GFX_Console_t con;
+
+        GFX_SetTextWrap(g, true);
+        GFX_SetTextSize(g, 1);
+        GFX_SetTextColor(g, SSD1331_WHITE);
+        GFX_PrintAt(g, &oled, 1, 1, "Lorem ipsum dolor sit amet, consectetur");
+        GFX_SetTextColorBg(g, SSD1331_YELLOW, SSD1331_BLUE);
+        GFX_SetTextSizeXY(g, 2, 1);
+        GFX_SetCursor(g, 3, 20);
+        GFX_Print(g, &oled, "Hi\n42");
+        GFX_DrawChar(g, &oled, w - 12, h - 16, 'Q', SSD1331_RED, SSD1331_RED, 2, 2);
+        GFX_SetTextSize(g, 1);
+        GFX_SetTextColorBg(g, SSD1331_GREEN, SSD1331_BLACK);
+        GFX_ConsoleInit(g, &con, 2, 30, w - 4, h - 32);
+        for (i = 0; i < 12; i++) {
+            GFX_ConsolePrint(g, &oled, &con, "line of text\n");
+        }
+        GFX_ConsoleClear(g, &oled, &con);
+    }
+    scene("text");
+
+    GFX_FillScreen(g, &oled, 0x18E3);
+    SSD1331_CopyRect(&oled, 0, 0, 20, 20, 30, 10);
+    scene("fill screen");
+}
+
+int main(int argc, char **argv) {
+    char path[512];
+    uint8_t rot;
+
+    (void)argc;
+    snprintf(path, sizeof(path), "%s.stream", argv[0]);
+    stream = fopen(path, "wb");
+    if (stream == NULL) {
+        perror(path);
+        return 1;
+    }
+
+    srand(16);
+    harness_begin(0);
+    for (rot = 0; rot < 4; rot++) {
+        SSD1331_SetRotation(&oled, rot);
+        shapes();
+
+        // The same workload inside a clip rectangle
+        GFX_SetClipRect(&oled.gfx, 7, 5, oled.gfx.width - 20, oled.gfx.height - 12);
+        shapes();
+        GFX_ResetClip(&oled.gfx);
+    }
+
+    fclose(stream);
+    CHECK(streamed > 0, "nothing was sent");
+    printf("%lu bytes written to %s\n", streamed, path);
+    return harness_end("static");
+}
@@ -0,0 +1,228 @@
+/**
+ * @file test_triangle.c
+ * @brief Filled triangles: pixel-identical to the previous rasteriser,
+ *        and gap-free tiling with GFX_FillTriangleTopLeft
+ *
+ * GFX_FillTriangle must draw the pixels of the division-based rasteriser
+ * it replaced on random and degenerate triangles, with and without a clip
+ * rectangle and with and without span hooks. GFX_FillTriangleTopLeft
+ * fills jittered triangle meshes, which must cover every pixel of the
+ * mesh exactly once. Both rasterisers are then timed on the
+ * testtriangles workload of main.c.
+ *
+ * @author @btondin
+ * @date 2025
+ */
+
+#include "harness.h"
+#include "canvas.h"
+#include <stdlib.h>
+#include <time.h>
+
+static int16_t min3(int16_t a, int16_t b, int16_t c) {
+    return (a < b) ? ((a < c) ? a : c) : ((b < c) ? b : c);
+}
+
+static int16_t max3(int16_t a, int16_t b, int16_t c) {
+    return (a > b) ? ((a > c) ? a : c) : ((b > c) ? b : c);
+}
+
+/**
+ * @brief The rasteriser GFX_FillTriangle used to be: two divisions per row
+ */
+static void ref_FillTriangle(GFX_t *gfx, void *display, int16_t x0, int16_t y0, int16_t x1, int16_t y1,
+                             int16_t x2, int16_t y2, uint16_t color) {
+    int16_t a, b, y, last;
+    int16_t dx01, dy01, dx02, dy02, dx12, dy12;
+    int32_t sa = 0, sb = 0;
+
+    if (y0 > y1) { GFX_Swap(&y0, &y1); GFX_Swap(&x0, &x1); }
+    if (y1 > y2) { GFX_Swap(&y2, &y1); GFX_Swap(&x2, &x1); }
+    if (y0 > y1) { GFX_Swap(&y0, &y1); GFX_Swap(&x0, &x1); }
+
+    if (!GFX_BoxVisible(gfx, min3(x0, x1, x2), y0, max3(x0, x1, x2), y2)) {
+        return;
+    }
+
+    if (y0 == y2) {
+        a = min3(x0, x1, x2);
+        b = max3(x0, x1, x2);
+        GFX_DrawFastHLine(gfx, display, a, y0, b - a + 1, color);
+        return;
+    }
+
+    dx01 = x1 - x0; dy01 = y1 - y0;
+    dx02 = x2 - x0; dy02 = y2 - y0;
+    dx12 = x2 - x1; dy12 = y2 - y1;
+
+    last = (y1 == y2) ? y1 : y1 - 1;
+    for (y = y0; y <= last; y++) {
+        a = x0 + (int16_t)(sa / dy01);
+        b = x0 + (int16_t)(sb / dy02);
+        sa += dx01;
+        sb += dx02;
+        if (a > b) GFX_Swap(&a, &b);
+        GFX_DrawFastHLine(gfx, display, a, y, b - a + 1, color);
+    }
+
+    sa = (int32_t)dx12 * (y - y1);
+    sb = (int32_t)dx02 * (y - y0);
+    for (; y <= y2; y++) {
+        a = x1 + (int16_t)(sa / dy12);
+        b = x0 + (int16_t)(sb / dy02);
+        sa += dx12;
+        sb += dx02;
+        if (a > b) GFX_Swap(&a, &b);
+        GFX_DrawFastHLine(gfx, display, a, y, b - a + 1, color);
+    }
+}
+
+/**
+ * @brief One triangle from args (x0, y0, x1, y1, x2, y2)
+ */
+static void draw_triangle(GFX_t *gfx, bool ref, const int16_t *v) {
+    (ref ? ref_FillTriangle : GFX_FillTriangle)(gfx, NULL, v[0], v[1], v[2], v[3], v[4], v[5], 1);
+}
+
+/** @brief Spans the timed rasterisers emitted */
+static volatile unsigned long spans;
+
+static void count_span(void *display, int16_t x, int16_t y, int16_t w, uint16_t color) {
+    (void)display; (void)x; (void)y; (void)w; (void)color;
+    spans++;
+}
+
+typedef void (*fill_fn)(GFX_t *, void *, int16_t, int16_t, int16_t, int16_t, int16_t, int16_t, uint16_t);
+
+/**
+ * @brief Nanoseconds per triangle for the testtriangles workload
+ *
+ * Spans go to a hook that only counts them, so the time is the
+ * rasteriser's own.
+ */
+static double time_triangles(fill_fn fill) {
+    GFX_t timing, *gfx = &timing;
+    struct timespec t0, t1;
+    double best = 1e30;
+    int run, rep, t;
+
+    GFX_Init(gfx, CANVAS_W, CANVAS_H);
+    gfx->drawFastHLine = count_span;
+    for (run = 0; run < 5; run++) {
+        clock_gettime(CLOCK_MONOTONIC, &t0);
+        for (rep = 0; rep < 2000; rep++) {
+            int16_t w = 48, x = 64, y = 0, z = 96;
+
+            for (t = 0; t <= 15; t++) {
+                fill(gfx, NULL, w, y, y, x, z, x, (uint16_t)t);
+                x -= 4;
+                y += 4;
+                z -= 4;
+            }
+        }
+        clock_gettime(CLOCK_MONOTONIC, &t1);
+        if ((t1.tv_sec - t0.tv_sec) * 1e9 + (t1.tv_nsec - t0.tv_nsec) < best) {
+            best = (t1.tv_sec - t0.tv_sec) * 1e9 + (t1.tv_nsec - t0.tv_nsec);
+        }
+    }
+    return best / (2000.0 * 16);
+}
+
+int main(void) {
+    GFX_t gfx;
+    unsigned long wrong = 0;
+    int hooks, t, i, j;
+
+    canvas_init(&gfx);
+    srand(19);
+
+    // Default rasteriser: the exact pixels of the old one
+    for (hooks = 1; hooks >= 0; hooks--) {
+        canvas_diff_t diff = {0};
+
+        if (!hooks) {
+            canvas_pixels_only(&gfx);
+        }
+        for (t = 0; t < 100000; t++) {
+            int16_t v[6];
+            int range = (t & 1) ? 20 : 130;
+
+            for (i = 0; i < 6; i++) {
+                v[i] = (int16_t)((range == 130) ? rand() % range - 17 : rand() % range + ((i & 1) ? 20 : 30));
+            }
+            if (t % 7 == 0) {
+                v[3] = v[1];                // Flat top or bottom
+            }
+            if (t % 11 == 0) {
+                v[3] = v[5] = v[1];         // All on one row
+            }
+            if (t % 3 == 0) {
+                GFX_SetClipRect(&gfx, 5, 7, 60, 40);
+            } else {
+                GFX_ResetClip(&gfx);
+            }
+            canvas_compare(&gfx, "triangle", draw_triangle, v, 6, &diff);
+        }
+        canvas_report(hooks ? "triangles with span hooks" : "triangles pixel by pixel", &diff);
+    }
+    canvas_init(&gfx);
+
+    // Top-left rule: a jittered mesh over [2, 90) x [2, 62) covers each pixel once
+    for (t = 0; t < 300; t++) {
+        int16_t X[7][9], Y[7][9];
+
+        for (j = 0; j < 7; j++) {
+            for (i = 0; i < 9; i++) {
+                X[j][i] = (int16_t)(i * 11 + 2 + ((i > 0 && i < 8) ? rand() % 5 - 2 : 0));
+                Y[j][i] = (int16_t)(j * 10 + 2 + ((j > 0 && j < 6) ? rand() % 5 - 2 : 0));
+            }
+        }
+        canvas_clear();
+        for (j = 0; j < 6; j++) {
+            for (i = 0; i < 8; i++) {
+                if (rand() & 1) {
+                    GFX_FillTriangleTopLeft(&gfx, NULL, X[j][i], Y[j][i], X[j][i + 1], Y[j][i + 1],
+                                            X[j + 1][i + 1], Y[j + 1][i + 1], 1);
+                    GFX_FillTriangleTopLeft(&gfx, NULL, X[j][i], Y[j][i], X[j + 1][i + 1], Y[j + 1][i + 1],
+                                            X[j + 1][i], Y[j + 1][i], 1);
+                } else {
+                    GFX_FillTriangleTopLeft(&gfx, NULL, X[j][i], Y[j][i], X[j][i + 1], Y[j][i + 1],
+                                            X[j + 1][i], Y[j + 1][i], 1);
+                    GFX_FillTriangleTopLeft(&gfx, NULL, X[j + 1][i], Y[j + 1][i], X[j][i + 1], Y[j][i + 1],
+                                            X[j + 1][i + 1], Y[j + 1][i + 1], 1);
+                }
+            }
+        }
+        for (j = 0; j < CANVAS_H; j++) {
+            for (i = 0; i < CANVAS_W; i++) {
+                int inside = (i >= 2 && i < 90 && j >= 2 && j < 62);
+
+                if (canvas_hits[j][i] != inside && wrong++ < 5) {
+                    printf("mesh %d: pixel (%d,%d) drawn %u times\n", t, i, j, canvas_hits[j][i]);
+                }
+            }
+        }
+    }
+    CHECK(wrong == 0, "%lu mesh pixels not covered exactly once", wrong);
+
+    // Degenerate triangles have no area under the top-left rule
+    canvas_clear();
+    GFX_FillTriangleTopLeft(&gfx, NULL, 10, 10, 40, 10, 70, 10, 1);
+    GFX_FillTriangleTopLeft(&gfx, NULL, 10, 10, 20, 20, 30, 30, 1);
+    CHECK(canvas_calls == 0, "a triangle without area drew %lu spans", canvas_calls);
+
+    // On the PIC the divisions dominate: software int32 division takes
+    // hundreds of cycles, so report them next to the host timings
+    {
+        double before = time_triangles(ref_FillTriangle), after;
+        unsigned long rows = spans / 5 / 2000;
+
+        spans = 0;
+        after = time_triangles(GFX_FillTriangle);
+        printf("testtriangles, %lu rows per pass of 16 triangles:\n", rows);
+        printf("  previous:         %4.0f ns/triangle on the host, %lu int32 divisions per pass\n", before, 2 * rows);
+        printf("  GFX_FillTriangle: %4.0f ns/triangle on the host, at most %d int16 divisions per pass\n", after, 3 * 16);
+    }
+
+    return harness_end("triangle");
+}
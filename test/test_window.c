@@ -0,0 +1,223 @@
+/**
+ * @file test_window.c
+ * @brief Address window cache: command bytes per frame and invalidation
+ *
+ * Draws the lcdTestPattern frame pixel by pixel in every rotation and
+ * checks that it costs a single SETCOLUMN/SETROW pair, that redrawing a
+ * window whose write pointer has wrapped sends no window commands, and
+ * that SSD1331_SetRotation and the drawing engine commands force the
+ * window to be sent again. A random mix of pixels, sequential runs, fills
+ * and rotation changes is then checked against an image kept by the
+ * test, so a stale cache shows up as misplaced pixels.
+ *
+ * @author @btondin
+ * @date 2025
+ */
+
+#include "harness.h"
+#include <stdlib.h>
+#include <string.h>
+
+/** @brief Bytes of one SETCOLUMN/SETROW pair */
+#define WINDOW_BYTES    6
+
+/** @brief Image the panel should show, in GDDRAM order */
+static uint16_t want[PANEL_ROWS][PANEL_COLS];
+
+/**
+ * @brief Record a pixel given in the coordinates of the current rotation
+ *
+ * Rotations 1 and 3 use vertical address increment with the column and
+ * row addresses swapped; the mirroring is done by the panel scan and
+ * does not show in GDDRAM.
+ */
+static void want_pixel(int16_t x, int16_t y, uint16_t color) {
+    if (x < 0 || y < 0 || x >= oled.gfx.width || y >= oled.gfx.height) {
+        return;
+    }
+    if (oled.rotation & 1) {
+        want[x][y] = color;
+    } else {
+        want[y][x] = color;
+    }
+}
+
+static void want_rect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {
+    int16_t i, j;
+
+    for (j = y; j < y + h; j++) {
+        for (i = x; i < x + w; i++) {
+            want_pixel(i, j, color);
+        }
+    }
+}
+
+static void compare(const char *what) {
+    unsigned bad = 0;
+    int r, c;
+
+    harness_settle();
+    for (r = 0; r < PANEL_ROWS; r++) {
+        for (c = 0; c < PANEL_COLS; c++) {
+            if (panel_ram[r][c] != want[r][c] && bad++ == 0) {
+                printf("%s: GDDRAM (%d,%d) is %04x, want %04x\n", what, c, r, panel_ram[r][c], want[r][c]);
+            }
+        }
+    }
+    CHECK(bad == 0, "%s (rotation %u): %u pixels differ", what, oled.rotation, bad);
+}
+
+/**
+ * @brief The colour bars of lcdTestPattern in main.c, one GFX_DrawPixel each
+ */
+static void test_pattern(uint16_t xor) {
+    static const uint16_t colors[] = {
+        SSD1331_BLACK, SSD1331_YELLOW, SSD1331_MAGENTA, SSD1331_RED,
+        SSD1331_CYAN, SSD1331_GREEN, SSD1331_BLUE, SSD1331_WHITE
+    };
+    int16_t w, h;
+
+    for (h = 0; h < oled.gfx.height; h++) {
+        for (w = 0; w < oled.gfx.width; w++) {
+            int band = w / 12;
+
+            if (band > 7) {
+                band = 7;
+            }
+            GFX_DrawPixel(&oled.gfx, &oled, w, h, colors[band] ^ xor);
+            want_pixel(w, h, colors[band] ^ xor);
+        }
+    }
+}
+
+int main(void) {
+    static uint16_t bitmap[24 * 16];
+    panel_stats_t st;
+    uint8_t rot;
+    int t, i;
+
+    srand(3);
+    for (i = 0; i < 24 * 16; i++) {
+        bitmap[i] = (uint16_t)rand();
+    }
+
+    harness_begin(0);
+
+    for (rot = 0; rot < 4; rot++) {
+        SSD1331_SetRotation(&oled, rot);
+        SSD1331_FillScreen(&oled, 0);
+        harness_settle();
+        memset(want, 0, sizeof(want));
+
+        // A whole frame in scan order opens one window
+        test_pattern(0);
+        st = harness_settle();
+        CHECK(st.cmd_bytes == WINDOW_BYTES, "rotation %u: test pattern sent %lu command bytes", rot, st.cmd_bytes);
+        CHECK(st.data_bytes == (unsigned long)oled.gfx.width * oled.gfx.height * 2,
+              "rotation %u: test pattern sent %lu data bytes", rot, st.data_bytes);
+        compare("test pattern");
+
+        // The write pointer wrapped to (0, 0): the next frame needs no window
+        test_pattern(0x1234);
+        st = harness_settle();
+        CHECK(st.cmd_bytes == 0, "rotation %u: second frame sent %lu command bytes", rot, st.cmd_bytes);
+        compare("second frame");
+
+        // The same bitmap twice: the second one reuses the wrapped window
+        SSD1331_DrawFastRGBBitmap16(&oled, 5, 7, bitmap, 24, 16);
+        harness_settle();
+        SSD1331_DrawFastRGBBitmap16(&oled, 5, 7, bitmap, 24, 16);
+        st = harness_settle();
+        CHECK(st.cmd_bytes == 0, "rotation %u: repeated bitmap sent %lu command bytes", rot, st.cmd_bytes);
+        for (i = 0; i < 24 * 16; i++) {
+            want_pixel((int16_t)(5 + i % 24), (int16_t)(7 + i / 24), bitmap[i]);
+        }
+        compare("repeated bitmap");
+
+        // A drawing engine command invalidates the cached write pointer
+        SSD1331_DrawPixel(&oled, 10, 10, SSD1331_RED);
+        SSD1331_FillRect(&oled, 20, 20, 40, 30, SSD1331_BLUE);
+        harness_settle();
+        SSD1331_DrawPixel(&oled, 11, 10, SSD1331_GREEN);
+        st = harness_settle();
+        CHECK(st.cmd_bytes == WINDOW_BYTES, "rotation %u: pixel after a fill sent %lu command bytes", rot, st.cmd_bytes);
+        want_pixel(10, 10, SSD1331_RED);
+        want_rect(20, 20, 40, 30, SSD1331_BLUE);
+        want_pixel(11, 10, SSD1331_GREEN);
+
+        SSD1331_DrawPixel(&oled, 12, 10, SSD1331_RED);
+        SSD1331_ClearWindow(&oled, 30, 30, 50, 50);
+        harness_settle();
+        SSD1331_DrawPixel(&oled, 13, 10, SSD1331_GREEN);
+        st = harness_settle();
+        CHECK(st.cmd_bytes == WINDOW_BYTES, "rotation %u: pixel after a clear sent %lu command bytes", rot, st.cmd_bytes);
+        want_pixel(12, 10, SSD1331_RED);
+        want_rect(30, 30, 21, 21, 0);
+        want_pixel(13, 10, SSD1331_GREEN);
+        compare("engine commands");
+    }
+
+    // A rotation change moves every logical address: the window must go out again
+    SSD1331_SetRotation(&oled, 0);
+    SSD1331_FillScreen(&oled, 0);
+    harness_settle();
+    memset(want, 0, sizeof(want));
+    SSD1331_DrawPixel(&oled, 0, 0, SSD1331_RED);
+    SSD1331_SetRotation(&oled, 1);
+    SSD1331_DrawPixel(&oled, 1, 0, SSD1331_GREEN);
+    want_pixel(1, 0, SSD1331_GREEN);
+    SSD1331_SetRotation(&oled, 0);
+    want_pixel(0, 0, SSD1331_RED);
+    compare("rotation change");
+
+    // Random pixels and runs mixed with fills, spans and rotation changes
+    for (t = 0; t < 3000; t++) {
+        int16_t x = (int16_t)(rand() % (oled.gfx.width + 8) - 4);
+        int16_t y = (int16_t)(rand() % (oled.gfx.height + 8) - 4);
+        int16_t n = (int16_t)(1 + rand() % 150);
+        uint16_t color = (uint16_t)rand();
+
+        switch (rand() % 8) {
+            case 0:
+            case 1:
+            case 2:
+                SSD1331_DrawPixel(&oled, x, y, color);
+                want_pixel(x, y, color);
+                break;
+            case 3:
+            case 4:
+                // A run in scan order, wrapping at the right edge
+                for (i = 0; i < n; i++) {
+                    int16_t px = (int16_t)((x + i) % oled.gfx.width);
+                    int16_t py = (int16_t)(y + (x + i) / oled.gfx.width);
+
+                    SSD1331_DrawPixel(&oled, px, py, (uint16_t)(color + i));
+                    want_pixel(px, py, (uint16_t)(color + i));
+                }
+                break;
+            case 5:
+                SSD1331_FillRect(&oled, x, y, (int16_t)(n % 60 + 1), (int16_t)(n % 40 + 1), color);
+                want_rect(x, y, (int16_t)(n % 60 + 1), (int16_t)(n % 40 + 1), color);
+                break;
+            case 6:
+                if (n & 1) {
+                    SSD1331_DrawFastHLine(&oled, x, y, n, color);
+                    want_rect(x, y, n, 1, color);
+                } else {
+                    SSD1331_DrawFastVLine(&oled, x, y, n, color);
+                    want_rect(x, y, 1, n, color);
+                }
+                break;
+            default:
+                if (rand() % 8 == 0) {
+                    SSD1331_SetRotation(&oled, (uint8_t)(rand() % 4));
+                }
+                break;
+        }
+        if (t % 500 == 499) {
+            compare("random drawing");
+        }
+    }
+
+    return harness_end("window");
+}